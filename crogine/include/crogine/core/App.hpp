@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/core/MessageBus.hpp>
 #include <crogine/core/Window.hpp>
 #include <crogine/core/Clock.hpp>
+#include <crogine/core/JobSystem.hpp>
 #include <crogine/detail/Types.hpp>
 
 #include <crogine/graphics/Colour.hpp>
@@ -86,6 +87,13 @@ namespace cro
         */
         static Window& getWindow();
 
+        /*!
+        \brief Returns a reference to the application's job system.
+        Jobs can be scheduled with this to be run on a pool of worker threads.
+        \see JobSystem
+        */
+        static JobSystem& getJobSystem();
+
         /*!
         \brief Returns a reference to the system message bus
         */
@@ -104,6 +112,39 @@ namespace cro
         */
         void resetFrameTime();
 
+        /*!
+        \brief Sets the number of times per second simulate() is called.
+        The simulation is always updated with a fixed timestep, and the
+        current state is rendered as often as the display allows. Lower
+        rates such as 30Hz can be used to reduce the CPU load on low end
+        hardware, with transform interpolation enabled in the SceneGraph
+        to keep motion smooth. Defaults to 60.
+        \see SceneGraph::setInterpolationEnabled()
+        */
+        void setTickRate(float ticksPerSecond);
+
+        /*!
+        \brief Returns the number of times per second simulate() is called
+        */
+        float getTickRate() const;
+
+        /*!
+        \brief Sets the maximum number of times simulate() may be called
+        in a single frame when catching up after a slow frame.
+        Any time beyond this is discarded so that a long stall, such as
+        loading, doesn't cause the simulation to fall further behind
+        trying to catch up. Defaults to 5.
+        */
+        void setMaxCatchUpSteps(uint32 steps);
+
+        /*!
+        \brief Returns how far between the last two simulation steps the
+        current frame is, in the range 0 - 1.
+        This is used to blend the previous and current simulation state
+        when rendering.
+        */
+        static float getInterpolationAlpha();
+
         /*!
         brief Returns a reference to the active App instance
         */
@@ -115,8 +156,7 @@ namespace cro
 		virtual void handleMessage(const cro::Message&) = 0;
 		/*!
         \brief Used to update the simulation with the time elapsed since the last update.
-        It is left to the user to decide if a specific system (such as physics)
-        requires fixed updates or not, which can be implemeted with a simple accumulator.
+        This is called with a fixed timestep, at the rate set with setTickRate().
         */
         virtual void simulate(Time) = 0;
         /*!
@@ -142,11 +182,17 @@ namespace cro
 
 	private:
 
+        //declared first so that it outlives anything which may schedule jobs
+        JobSystem m_jobSystem;
 		Window m_window;
 		Colour m_clearColour;
         Clock* m_frameClock;
         bool m_running;
 
+        Time m_frameTime;
+        uint32 m_maxCatchUpSteps;
+        float m_interpolationAlpha;
+
         void handleEvents();
 
         MessageBus m_messageBus;
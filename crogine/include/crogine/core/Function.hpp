@@ -0,0 +1,263 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/Assert.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cro
+{
+    template <typename Signature, std::size_t StorageSize = 48>
+    class Function;
+
+    /*!
+    \brief Type erased function wrapper, used in place of std::function
+    for callbacks which are created and copied frequently, such as Commands.
+    The target is stored in a fixed size buffer within the Function so
+    that lambdas with up to StorageSize bytes of captures are never
+    allocated on the heap, and copying or moving a Function never allocates.
+    Targets larger than StorageSize are still accepted, but are stored on
+    the heap as they would be with std::function.
+    As with std::function the target must be copy constructible.
+    */
+    template <typename R, typename... Args, std::size_t StorageSize>
+    class Function<R(Args...), StorageSize> final
+    {
+    public:
+        Function() = default;
+        Function(std::nullptr_t) {}
+
+        template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Function>::value
+            && std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>>
+        Function(F&& f)
+        {
+            assign(std::forward<F>(f));
+        }
+
+        Function(const Function& other)
+        {
+            copyFrom(other);
+        }
+
+        Function(Function&& other) noexcept
+        {
+            moveFrom(other);
+        }
+
+        ~Function()
+        {
+            reset();
+        }
+
+        Function& operator = (const Function& other)
+        {
+            if (&other != this)
+            {
+                reset();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        Function& operator = (Function&& other) noexcept
+        {
+            if (&other != this)
+            {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        Function& operator = (std::nullptr_t)
+        {
+            reset();
+            return *this;
+        }
+
+        template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Function>::value
+            && std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>>
+        Function& operator = (F&& f)
+        {
+            reset();
+            assign(std::forward<F>(f));
+            return *this;
+        }
+
+        /*!
+        \brief Invokes the target. The Function must not be empty.
+        */
+        R operator()(Args... args) const
+        {
+            CRO_ASSERT(m_invoke, "Function is empty");
+            return m_invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+        /*!
+        \brief Returns true if the Function has a target
+        */
+        explicit operator bool() const { return m_invoke != nullptr; }
+
+        /*!
+        \brief Destroys the target, leaving the Function empty
+        */
+        void reset()
+        {
+            if (m_manager)
+            {
+                m_manager(Operation::Destroy, m_storage, nullptr);
+            }
+            m_invoke = nullptr;
+            m_manager = nullptr;
+        }
+
+    private:
+        enum class Operation
+        {
+            Copy, Move, Destroy
+        };
+
+        using Invoker = R(*)(void*, Args&&...);
+        using Manager = void(*)(Operation, void*, void*);
+
+        //mutable so that targets with a non-const call operator
+        //can be invoked from a const Function, as std::function does
+        alignas(std::max_align_t) mutable unsigned char m_storage[StorageSize] = {};
+        Invoker m_invoke = nullptr;
+        Manager m_manager = nullptr; //null if the target can be copied with memcpy
+
+        template <typename F>
+        static constexpr bool storedInline()
+        {
+            return sizeof(F) <= StorageSize
+                && alignof(std::max_align_t) % alignof(F) == 0
+                && std::is_nothrow_move_constructible<F>::value;
+        }
+
+        template <typename F>
+        void assign(F&& f)
+        {
+            using Target = std::decay_t<F>;
+            static_assert(std::is_copy_constructible<Target>::value, "Function targets must be copy constructible");
+
+            if constexpr (storedInline<Target>())
+            {
+                new (m_storage) Target(std::forward<F>(f));
+                m_invoke = [](void* storage, Args&&... args) -> R
+                {
+                    return (*static_cast<Target*>(storage))(std::forward<Args>(args)...);
+                };
+
+                if constexpr (!std::is_trivially_copyable<Target>::value)
+                {
+                    m_manager = [](Operation op, void* dst, void* src)
+                    {
+                        switch (op)
+                        {
+                        case Operation::Copy:
+                            new (dst) Target(*static_cast<const Target*>(src));
+                            break;
+                        case Operation::Move:
+                            new (dst) Target(std::move(*static_cast<Target*>(src)));
+                            static_cast<Target*>(src)->~Target();
+                            break;
+                        case Operation::Destroy:
+                            static_cast<Target*>(dst)->~Target();
+                            break;
+                        }
+                    };
+                }
+            }
+            else
+            {
+                //too big to fit, so the storage holds a pointer instead
+                *reinterpret_cast<Target**>(m_storage) = new Target(std::forward<F>(f));
+                m_invoke = [](void* storage, Args&&... args) -> R
+                {
+                    return (**static_cast<Target**>(storage))(std::forward<Args>(args)...);
+                };
+
+                m_manager = [](Operation op, void* dst, void* src)
+                {
+                    switch (op)
+                    {
+                    case Operation::Copy:
+                        *static_cast<Target**>(dst) = new Target(**static_cast<Target* const*>(src));
+                        break;
+                    case Operation::Move:
+                        *static_cast<Target**>(dst) = *static_cast<Target**>(src);
+                        break;
+                    case Operation::Destroy:
+                        delete *static_cast<Target**>(dst);
+                        break;
+                    }
+                };
+            }
+        }
+
+        void copyFrom(const Function& other)
+        {
+            if (other.m_manager)
+            {
+                other.m_manager(Operation::Copy, m_storage, other.m_storage);
+            }
+            else
+            {
+                std::memcpy(m_storage, other.m_storage, StorageSize);
+            }
+            m_invoke = other.m_invoke;
+            m_manager = other.m_manager;
+        }
+
+        void moveFrom(Function& other)
+        {
+            if (other.m_manager)
+            {
+                other.m_manager(Operation::Move, m_storage, other.m_storage);
+            }
+            else
+            {
+                std::memcpy(m_storage, other.m_storage, StorageSize);
+            }
+            m_invoke = other.m_invoke;
+            m_manager = other.m_manager;
+
+            //the target has been moved from (or was never owned)
+            //so other must not destroy it again
+            other.m_invoke = nullptr;
+            other.m_manager = nullptr;
+        }
+    };
+}
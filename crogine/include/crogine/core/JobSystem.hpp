@@ -0,0 +1,190 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/core/Function.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief Tracks the number of outstanding jobs scheduled with it.
+    A counter is incremented when a job is scheduled with it and
+    decremented when that job completes. Counters can be waited on
+    with JobSystem::wait() or used as a dependency of other jobs,
+    which are then only run once the counter reaches zero.
+    Counters must outlive any jobs scheduled with them.
+    */
+    class CRO_EXPORT_API JobCounter final
+    {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter(JobCounter&&) = delete;
+        JobCounter& operator = (const JobCounter&) = delete;
+        JobCounter& operator = (JobCounter&&) = delete;
+
+        /*!
+        \brief Returns true if all jobs scheduled with this counter have completed
+        */
+        bool complete() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+    private:
+        std::atomic<std::int32_t> m_count = 0;
+
+        //jobs waiting on this counter, and the counters they were scheduled with
+        struct Continuation final
+        {
+            Function<void()> job;
+            JobCounter* counter = nullptr;
+        };
+        mutable std::mutex m_mutex;
+        std::vector<Continuation> m_continuations;
+
+        friend class JobSystem;
+    };
+
+    /*!
+    \brief Runs jobs on a fixed pool of worker threads.
+    An instance of the job system is owned by the App and can be
+    retrieved with App::getJobSystem(). Each worker owns a queue of
+    jobs, from which it takes the most recently added job first. Idle
+    workers steal the oldest jobs from the queues of other threads.
+    Jobs scheduled from threads which are not workers, such as the
+    main thread, are placed in a shared queue.
+
+    A thread waiting for a counter with wait() will execute other
+    pending jobs while it waits, so it is safe to wait from within
+    a job, and waiting on the main thread does not stall the pool.
+
+    Jobs must not throw exceptions. Jobs are stored in a cro::Function,
+    so those capturing up to 48 bytes are scheduled without allocating.
+    */
+    class CRO_EXPORT_API JobSystem final
+    {
+    public:
+        using Job = Function<void()>;
+
+        /*!
+        \brief Constructor.
+        \param threadCount Number of worker threads to create. If this is
+        zero then one fewer than the number of hardware threads is used, with
+        a minimum of one.
+        */
+        explicit JobSystem(std::size_t threadCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator = (const JobSystem&) = delete;
+        JobSystem& operator = (JobSystem&&) = delete;
+
+        /*!
+        \brief Schedules a job to be run on the worker pool.
+        \param job The job to run
+        \param counter Optional counter which is incremented now and
+        decremented once the job has completed.
+        */
+        void schedule(Job job, JobCounter* counter = nullptr);
+
+        /*!
+        \brief Schedules a job which will not be run until the given
+        dependency counter reaches zero.
+        \param job The job to run
+        \param dependency The job is queued once this counter is complete.
+        If it is already complete the job is queued immediately.
+        \param counter Optional counter which is incremented now and
+        decremented once the job has completed.
+        */
+        void schedule(Job job, JobCounter& dependency, JobCounter* counter = nullptr);
+
+        /*!
+        \brief Blocks until the given counter is complete, executing any
+        other pending jobs in the meantime. When there are no jobs left to
+        execute the thread sleeps until either a job is scheduled or the
+        counter completes, rather than spinning.
+        */
+        void wait(const JobCounter&);
+
+        /*!
+        \brief Splits the range [0, count) into chunks of at most grainSize
+        and calls func(begin, end) for each chunk on the worker pool.
+        Returns once all chunks have completed. The calling thread also
+        executes chunks while it waits.
+        */
+        template <typename Func>
+        void parallelFor(std::size_t count, std::size_t grainSize, Func&& func);
+
+        /*!
+        \brief Returns the number of worker threads in the pool
+        */
+        std::size_t getThreadCount() const { return m_threads.size(); }
+
+    private:
+        struct JobData final
+        {
+            Job job;
+            JobCounter* counter = nullptr;
+        };
+
+        //index 0 is shared by any thread which is not a worker
+        struct Queue final
+        {
+            std::mutex mutex;
+            std::deque<JobData> jobs;
+        };
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_threads;
+
+        std::atomic<bool> m_running;
+        std::atomic<std::int32_t> m_queuedCount;
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCondition;
+        std::condition_variable m_waitCondition; //threads in wait()
+
+        void push(JobData&&);
+        bool pop(JobData&);
+        void execute(JobData&);
+        void threadFunc(std::size_t);
+    };
+
+#include "JobSystem.inl"
+}
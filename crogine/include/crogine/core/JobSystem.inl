@@ -0,0 +1,55 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+template <typename Func>
+void JobSystem::parallelFor(std::size_t count, std::size_t grainSize, Func&& func)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grainSize = std::max(std::size_t(1), grainSize);
+    if (count <= grainSize)
+    {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    JobCounter counter;
+    for (auto begin = grainSize; begin < count; begin += grainSize)
+    {
+        auto end = std::min(count, begin + grainSize);
+        schedule([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+
+    //do the first chunk ourselves rather than sit idle
+    func(std::size_t(0), grainSize);
+    wait(counter);
+}
@@ -32,6 +32,13 @@ source distribution.
 #include <crogine/core/Message.hpp>
 
 #include <vector>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
+#include <new>
+#include <utility>
 
 namespace cro
 {   
@@ -50,6 +57,11 @@ namespace cro
     GhostEvent,
     BadgerEvent //etc...
     };
+
+    Messages may be posted from any thread. Each frame's messages are
+    allocated from a set of pages which grow as needed, rather than
+    overflowing, and which are reused once the messages have been read.
+    Messages are only ever read on the main thread.
     */
     class CRO_EXPORT_API MessageBus final
     {
@@ -77,29 +89,28 @@ namespace cro
         Custom message types should have a unique 32 bit integer ID which can be used
         to identify the message type when reading messages. Message data has a maximum
         size of 128 bytes.
+        Threads other than the main thread should use the overload of post() which
+        takes the message data, as the data returned here may be read before it is filled.
         \param id Unique ID for this message type
         \returns Pointer to an empty message of given type.
         */
         template <typename T>
         T* post(Message::ID id)
         {
-            if (!m_enabled) return static_cast<T*>((void*)m_pendingBuffer.data());
-
-            auto dataSize = sizeof(T);
-            static auto msgSize = sizeof(Message);
-            CRO_ASSERT(dataSize < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
-            CRO_ASSERT(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) >(dataSize + msgSize), "buffer overflow " + std::to_string(m_pendingCount)); //make sure we have enough room in the buffer
-            //CRO_WARNING(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) < 128, "Messagebus buffer is heavily contended!");
-
-            Message* msg = new (m_inPointer)Message();
-            m_inPointer += msgSize;
-            msg->id = id;
-            msg->m_dataSize = dataSize;
-            msg->m_data = new (m_inPointer)T();
-            m_inPointer += dataSize;
+            return emplace<T>(id);
+        }
 
-            m_pendingCount++;
-            return static_cast<T*>(msg->m_data);
+        /*!
+        \brief Places a copy of the given data on the message stack.
+        The message is complete before it can be read, so this is the
+        safe way to post messages from threads other than the main thread.
+        \param id Unique ID for this message type
+        \param data Message data to copy to the message bus
+        */
+        template <typename T>
+        void post(Message::ID id, const T& data)
+        {
+            emplace<T>(id, data);
         }
 
         /*!
@@ -120,14 +131,67 @@ namespace cro
         void disable() { m_enabled = false; }
 
     private:
+        static constexpr std::size_t Alignment = alignof(std::max_align_t);
+        static constexpr std::size_t alignedSize(std::size_t size) { return (size + (Alignment - 1)) & ~(Alignment - 1); }
+        static constexpr std::size_t HeaderSize = (sizeof(Message) + (Alignment - 1)) & ~(Alignment - 1);
+
+        struct Page final
+        {
+            explicit Page(std::size_t);
+            std::unique_ptr<char[]> data;
+            std::size_t size = 0;
+            std::atomic<std::size_t> offset;
+            std::atomic<std::size_t> end; //start of the first allocation which didn't fit
+        };
+
+        struct Frame final
+        {
+            std::vector<Page*> pages;
+            std::atomic<Page*> currentPage;
+            std::atomic<std::size_t> messageCount;
+        };
+
+        std::vector<std::unique_ptr<Page>> m_pages;
+        std::vector<Page*> m_freePages;
+        std::mutex m_pageMutex;
 
-        std::vector<char> m_currentBuffer;
-        std::vector<char> m_pendingBuffer;
-        char* m_inPointer;
-        char* m_outPointer;
+        std::array<Frame, 2u> m_frames;
+        std::atomic<Frame*> m_pendingFrame;
+        std::atomic<std::size_t> m_activePosts;
+
+        //read on the main thread only
+        Frame* m_currentFrame;
         std::size_t m_currentCount;
-        std::size_t m_pendingCount;
+        std::size_t m_outPage;
+        std::size_t m_outOffset;
+
+        std::atomic<bool> m_enabled;
+        alignas(Alignment) std::array<char, 128u> m_disabledBuffer = {};
+
+        template <typename T, typename... Args>
+        T* emplace(Message::ID id, Args&&... args)
+        {
+            if (!m_enabled) return reinterpret_cast<T*>(m_disabledBuffer.data());
+
+            auto dataSize = sizeof(T);
+            CRO_ASSERT(dataSize < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
+
+            auto* ptr = beginPost(HeaderSize + alignedSize(dataSize));
+            Message* msg = new (ptr)Message();
+            msg->id = id;
+            msg->m_dataSize = dataSize;
+            msg->m_data = new (ptr + HeaderSize)T(std::forward<Args>(args)...);
+            endPost();
+
+            return static_cast<T*>(msg->m_data);
+        }
+
+        //reserves space for a message on the pending frame. every
+        //call must be followed by endPost() once the message is written
+        char* beginPost(std::size_t);
+        void endPost() { m_activePosts.fetch_sub(1, std::memory_order_release); }
 
-        bool m_enabled;
+        Page* acquirePage();
+        void resetFrame(Frame&);
     };
 }
\ No newline at end of file
@@ -46,13 +46,17 @@ namespace cro
         using ID = uint32;
 
         /*!
-        \brief Returns a unique ID based on the component type
+        \brief Returns a unique ID based on the component type.
+        The ID is looked up from the library's registry only the first
+        time it is requested for a given type, after which it is cached
+        in a function local static. The registry itself lives in the
+        library so that IDs remain consistent across module boundaries.
         */
         template <typename T>
         static ID getID()
         {
-            auto id = std::type_index(typeid(T));
-            return getFromTypeID(id);
+            static const ID id = getFromTypeID(std::type_index(typeid(T)));
+            return id;
         }
 
     private:
@@ -32,6 +32,8 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 
 #include <vector>
+#include <limits>
+#include <cstdint>
 
 namespace cro
 {
@@ -42,31 +44,157 @@ namespace cro
 		public:
 			virtual ~Pool() = default;
 			virtual void clear() = 0;
+
+			/*!
+			\brief Returns true if the entity at the given index has
+			a component in this pool.
+			*/
+			virtual bool contains(std::size_t entityIndex) const = 0;
+
+			/*!
+			\brief Removes the component belonging to the entity at the
+			given index, if it exists.
+			*/
+			virtual void remove(std::size_t entityIndex) = 0;
+
+			/*!
+			\brief Returns the number of live components in the pool
+			*/
+			virtual std::size_t size() const = 0;
 		};
 
 		/*!
-		\brief memory pooling for components - TODO map component to ID
+		\brief Memory pooling for components.
+		Components are stored as a sparse set: the sparse array maps an
+		entity index to a slot in the densely packed component array, so
+		the pool only ever holds live components, contiguously. Lookup
+		by entity index is O(1), as are insertion and (swap and pop) removal.
+		Note that removing a component moves the last component in the
+		pool into the vacated slot, so references to components should
+		not be held across a call to remove().
 		*/
 		template <class T>
 		class ComponentPool final : public Pool
 		{
 		public:
-			explicit ComponentPool(std::size_t size = 100){	resize(size); }
-
-			bool empty() const { return m_pool.empty(); }
-			std::size_t size() const { return m_pool.size(); }
-			void resize(std::size_t size) { m_pool.resize(size); }
-			void clear() { m_pool.clear(); }
-			void add(T c) { m_pool.push_back(c); }
-
-            T& at(std::size_t idx) { return m_pool[idx]; }
-            const T& at(std::size_t idx) const { return m_pool[idx]; }
-
-			T& operator [] (std::size_t index) { return m_pool[index]; }
-			const T& operator [] (std::size_t index) const { return m_pool[index]; }
+			static constexpr std::uint32_t NullIndex = std::numeric_limits<std::uint32_t>::max();
+
+			explicit ComponentPool(std::size_t reserveSize = 100)
+			{
+				m_dense.reserve(reserveSize);
+				m_denseIndices.reserve(reserveSize);
+			}
+
+			bool empty() const { return m_dense.empty(); }
+			std::size_t size() const override { return m_dense.size(); }
+
+			/*!
+			\brief Reserves space for at least this many components in total
+			*/
+			void reserve(std::size_t count)
+			{
+				m_dense.reserve(count);
+				m_denseIndices.reserve(count);
+			}
+
+			void clear() override
+			{
+				m_dense.clear();
+				m_denseIndices.clear();
+				m_sparse.clear();
+			}
+
+			bool contains(std::size_t entityIndex) const override
+			{
+				return entityIndex < m_sparse.size() && m_sparse[entityIndex] != NullIndex;
+			}
+
+			/*!
+			\brief Inserts the given component for the entity at the given index.
+			If the entity already has a component in this pool it is replaced.
+			\returns Reference to the inserted component
+			*/
+			T& insert(std::size_t entityIndex, T&& component)
+			{
+				if (entityIndex >= m_sparse.size())
+				{
+					m_sparse.resize(entityIndex + 1, NullIndex);
+				}
+
+				if (m_sparse[entityIndex] != NullIndex)
+				{
+					auto& existing = m_dense[m_sparse[entityIndex]];
+					existing = std::move(component);
+					return existing;
+				}
+
+				m_sparse[entityIndex] = static_cast<std::uint32_t>(m_dense.size());
+				m_denseIndices.push_back(static_cast<std::uint32_t>(entityIndex));
+				m_dense.push_back(std::move(component));
+				return m_dense.back();
+			}
+
+			void remove(std::size_t entityIndex) override
+			{
+				if (!contains(entityIndex))
+				{
+					return;
+				}
+
+				const auto slot = m_sparse[entityIndex];
+				const auto last = static_cast<std::uint32_t>(m_dense.size() - 1);
+				if (slot != last)
+				{
+					m_dense[slot] = std::move(m_dense[last]);
+					m_denseIndices[slot] = m_denseIndices[last];
+					m_sparse[m_denseIndices[slot]] = slot;
+				}
+				m_dense.pop_back();
+				m_denseIndices.pop_back();
+				m_sparse[entityIndex] = NullIndex;
+			}
+
+			/*!
+			\brief Returns the component belonging to the entity at the given index
+			*/
+			T& at(std::size_t entityIndex)
+			{
+				CRO_ASSERT(contains(entityIndex), "Entity has no component in this pool");
+				return m_dense[m_sparse[entityIndex]];
+			}
+
+			const T& at(std::size_t entityIndex) const
+			{
+				CRO_ASSERT(contains(entityIndex), "Entity has no component in this pool");
+				return m_dense[m_sparse[entityIndex]];
+			}
+
+			T& operator [] (std::size_t entityIndex) { return at(entityIndex); }
+			const T& operator [] (std::size_t entityIndex) const { return at(entityIndex); }
+
+			/*!
+			\brief Dense iteration. Components are visited in pool order,
+			which is not necessarily the order in which entities were created.
+			Use getEntityIndices() to find the entity index of a component
+			at the same position.
+			*/
+			typename std::vector<T>::iterator begin() { return m_dense.begin(); }
+			typename std::vector<T>::iterator end() { return m_dense.end(); }
+			typename std::vector<T>::const_iterator begin() const { return m_dense.begin(); }
+			typename std::vector<T>::const_iterator end() const { return m_dense.end(); }
+
+			T* data() { return m_dense.data(); }
+			const T* data() const { return m_dense.data(); }
+
+			/*!
+			\brief Returns the entity indices of each component, in dense order
+			*/
+			const std::vector<std::uint32_t>& getEntityIndices() const { return m_denseIndices; }
 
 		private:
-			std::vector<T> m_pool;
+			std::vector<T> m_dense;
+			std::vector<std::uint32_t> m_denseIndices; //entity index of each dense component
+			std::vector<std::uint32_t> m_sparse; //indexed by entity index, the slot in m_dense
 		};
 	}
 }
\ No newline at end of file
@@ -33,6 +33,8 @@ source distribution.
 #include <crogine/detail/Types.hpp>
 #include <crogine/core/MessageBus.hpp>
 
+#include <vector>
+
 namespace cro
 {
     class Message;
@@ -64,7 +66,9 @@ namespace cro
 
     protected:
         /*!
-        \brief Implement to handle system messages
+        \brief Implement to handle system messages.
+        Directors receive every message unless they declare the
+        message IDs they are interested in via subscribe().
         */
         virtual void handleMessage(const Message&) = 0;
 
@@ -90,12 +94,27 @@ namespace cro
         */
         void sendCommand(const Command&);
 
+        /*!
+        \brief Moves a Command to the Scene
+        \see CommandSystem
+        */
+        void sendCommand(Command&&);
+
         /*!
         \brief Returns a reference to this Director's parent Scene
         */
         Scene& getScene();
 
+        /*!
+        \brief Registers interest in messages of the given ID.
+        Once a director has subscribed to at least one ID only
+        messages with a subscribed ID are passed to handleMessage().
+        */
+        void subscribe(Message::ID id);
+
     private:
+        std::vector<Message::ID> m_subscriptions;
+        bool wantsMessage(Message::ID) const;
 
         MessageBus* m_messageBus;
         CommandSystem* m_commandSystem;
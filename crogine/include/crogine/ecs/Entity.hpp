@@ -38,7 +38,6 @@ source distribution.
 
 #include <bitset>
 #include <vector>
-#include <deque>
 #include <memory>
 
 namespace cro
@@ -50,7 +49,9 @@ namespace cro
 			MaxComponents = 64, //this is max number of types on a single entity
 			IndexBits = 24,
 			GenerationBits = 8,
-			MinFreeIDs = 1024 //after this generation is incremented and we go back to zero
+			MaxGeneration = (1 << GenerationBits) - 1, //indices are retired on reaching this so handles never alias
+			MinFreeIDs = 1024, //an index isn't reused until at least this many are free, so generations increase slowly
+			DefaultEntityCapacity = 1024 //storage is initially reserved for this many entities
 		};
 	}
 	
@@ -100,16 +101,22 @@ namespace cro
 
 		/*
 		\brief Constructs a component from the given parameters,
-		adds it to the entity and returns a reference to it
+		adds it to the entity and returns a reference to it.
+		The reference is subject to the same lifetime as those
+		returned by getComponent().
 		*/
 		template <typename T, typename... Args>
 		T& addComponent(Args&&...);
 
 		/*!
-		\brief Removes the component of this type if it exists
+		\brief Removes the component of this type.
+		The entity reports that it no longer has the component
+		immediately, but the component data remains valid until
+		the next Scene::simulate(), at which point the entity is
+		removed from any systems which required the component.
 		*/
-		/*template <typename T>
-		void removeComponent()*/;
+		template <typename T>
+		void removeComponent();
 
 		/*!
 		\brief returns true if the component type exists on thie entity
@@ -118,7 +125,14 @@ namespace cro
 		bool hasComponent() const;
 
 		/*!
-		\brief Returns a reference to the component if it exists
+		\brief Returns a reference to the component if it exists.
+		Components of each type are packed together in a pool, and may
+		be moved within it. The reference must not be kept beyond the
+		current frame: it is invalidated when a component of the same
+		type is added to any entity, and when the next Scene::simulate()
+		releases destroyed entities or removed components, as the last
+		component in the pool is moved in to the freed slot. Store the
+		Entity instead and call getComponent() again when needed.
 		*/
 		template <typename T>
         T& getComponent();
@@ -165,13 +179,20 @@ namespace cro
 	};
 
     class MessageBus;
+    class Prefab;
     /*!
     \brief Manages the relationship between an Entity and its components
     */
     class CRO_EXPORT_API EntityManager final
     {
     public:
-        explicit EntityManager(MessageBus&);
+        /*!
+        \brief Constructor.
+        \param mb Reference to the system message bus
+        \param initialCapacity Storage is reserved up front for this many entities.
+        The manager will grow beyond this if necessary.
+        */
+        explicit EntityManager(MessageBus& mb, std::size_t initialCapacity = Detail::DefaultEntityCapacity);
 
         ~EntityManager() = default;
         EntityManager(const EntityManager&) = delete;
@@ -184,7 +205,8 @@ namespace cro
         */
         Entity createEntity();
         /*!
-        \brief Destroys the given Entity
+        \brief Destroys the given Entity.
+        Destroying an entity which has already been destroyed does nothing.
         */
         void destroyEntity(Entity);
         /*!
@@ -209,10 +231,13 @@ namespace cro
         T& addComponent(Entity, Args&&... args);
 
         /*!
-        \brief Removes this component type for the given Entity
+        \brief Removes this component type from the given Entity.
+        The component mask is updated immediately, but the component data
+        is not released until flushComponentChanges() is called, so that
+        any systems which are still processing the entity may safely do so.
         */
-        /*template <typename T>
-        void removeComponent(Entity);*/
+        template <typename T>
+        void removeComponent(Entity);
 
         /*!
         \brief Returns true if the given Entity has a component of this type
@@ -238,15 +263,52 @@ namespace cro
         */
         bool owns(Entity) const;
 
+        /*!
+        \brief Returns the pool containing all the components of this type.
+        Components are packed contiguously in the pool, so iterating over it
+        directly is much more cache friendly than looking up each component
+        via an Entity. Pools are created on demand.
+        */
+        template <typename T>
+        Detail::ComponentPool<T>& getComponentPool();
+
+        /*!
+        \brief Copies the components of the given Prefab on to each of the
+        given entities. Each component type is copied straight in to its pool
+        and the component masks are updated once per entity. The entities are
+        expected to be newly created, so they are not marked as changed and
+        should be added to systems along with any other new entities.
+        */
+        void instantiate(const Prefab&, const std::vector<Entity>&);
+
+        /*!
+        \brief Returns a list of entities which have had components
+        added or removed since the last call to flushComponentChanges()
+        */
+        const std::vector<Entity>& getChangedEntities() const { return m_changedEntities; }
+
+        /*!
+        \brief Releases the data of any removed components and clears
+        the list of changed entities. This is called by the Scene once
+        the system membership of the changed entities has been updated.
+        */
+        void flushComponentChanges();
+
     private:
         MessageBus& m_messageBus;
-        std::deque<Entity::ID> m_freeIDs;
+        //used as a FIFO queue - IDs are popped from m_freeHead and the
+        //consumed front of the vector is discarded once it's half the size
+        std::vector<Entity::ID> m_freeIDs;
+        std::size_t m_freeHead;
         std::vector<Entity::Generation> m_generations; // < indexed by entity ID
-        std::vector<std::unique_ptr<Detail::Pool>> m_componentPools; // < index is component ID. Pool index is entity ID.
+        std::vector<std::unique_ptr<Detail::Pool>> m_componentPools; // < index is component ID. Pools are sparse sets indexed by entity ID.
         std::vector<ComponentMask> m_componentMasks;
 
-        template <typename T>
-        Detail::ComponentPool<T>& getPool();
+        std::vector<Entity> m_changedEntities;
+        std::vector<bool> m_changeFlags; // < indexed by entity ID, true if in m_changedEntities
+        std::vector<std::pair<Entity::ID, Component::ID>> m_pendingRemovals;
+
+        void markChanged(Entity);
     };
 
 #include "Entity.inl"
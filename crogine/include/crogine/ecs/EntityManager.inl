@@ -33,14 +33,11 @@ void EntityManager::addComponent(Entity entity, T component)
     auto componentID = Component::getID<T>();
     auto entID = entity.getIndex();
 
-    auto& pool = getPool<T>();
-    if (entID >= pool.size())
-    {
-        pool.resize(m_generations.size());
-    }
-
-    pool[entID] = std::move(component);
+    auto& pool = getComponentPool<T>();
+    pool.insert(entID, std::move(component));
     m_componentMasks[entID].set(componentID);
+
+    markChanged(entity);
 }
 
 template <typename T, typename... Args>
@@ -51,17 +48,21 @@ T& EntityManager::addComponent(Entity entity, Args&&... args)
     return getComponent<T>(entity);
 }
 
-//TODO this doesn't remove the entity from active systems...
-//template <typename T>
-//void EntityManager::removeComponent(Entity entity)
-//{
-//    const auto componentID = Component::getID<T>();
-//    const auto entityID = entity.getIndex();
-//
-//    CRO_ASSERT(entityID < m_componentMasks.size(), "Entity index out of range");
-//    m_componentMasks[entityID].set(componentID, false);
-//    
-//}
+template <typename T>
+void EntityManager::removeComponent(Entity entity)
+{
+    const auto componentID = Component::getID<T>();
+    const auto entityID = entity.getIndex();
+
+    CRO_ASSERT(hasComponent<T>(entity), "Component does not exist!");
+
+    //the data is released in flushComponentChanges() once
+    //the entity has been removed from any interested systems
+    m_componentMasks[entityID].set(componentID, false);
+    m_pendingRemovals.emplace_back(entityID, componentID);
+
+    markChanged(entity);
+}
 
 template <typename T>
 bool EntityManager::hasComponent(Entity entity) const
@@ -79,18 +80,19 @@ T& EntityManager::getComponent(Entity entity)
     const auto componentID = Component::getID<T>();
     const auto entityID = entity.getIndex();
 
-    CRO_ASSERT(hasComponent<T>(entity), "Component does not exist!");
-
-
+    //this doesn't test the component mask as removed components
+    //remain valid until the next call to flushComponentChanges()
     CRO_ASSERT(componentID < m_componentPools.size(), "Component index out of range");
-    auto* pool = (dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    CRO_ASSERT(m_componentPools[componentID], "Component does not exist!");
+    //IDs are unique per type so the pool is guaranteed to be of this type
+    auto* pool = static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get());
 
-    CRO_ASSERT(entityID < pool->size(), "Entity index out of range");
+    CRO_ASSERT(pool->contains(entityID), "Component does not exist!");
     return pool->at(entityID);
 }
 
 template <typename T>
-Detail::ComponentPool<T>& EntityManager::getPool()
+Detail::ComponentPool<T>& EntityManager::getComponentPool()
 {
     const auto componentID = Component::getID<T>();
 
@@ -99,5 +101,5 @@ Detail::ComponentPool<T>& EntityManager::getPool()
         m_componentPools[componentID] = std::make_unique<Detail::ComponentPool<T>>();
     }
 
-    return *(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    return *static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get());
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/ecs/Entity.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace cro
+{
+    class Scene;
+
+    /*!
+    \brief A set of components which can be copied on to many entities at once.
+    Rather than build each entity by hand with a series of addComponent() calls,
+    a Prefab is set up once, and Scene::instantiate() used to create any number
+    of entities with a copy of the Prefab's components. Components are copied
+    straight in to their pools, one type at a time, and each entity's component
+    mask is set once. The new entities are added to systems together at the
+    beginning of the next Scene::simulate(), without the per-component updates
+    made by Entity::addComponent().
+    \code
+    cro::Prefab prefab;
+    prefab.addComponent<cro::Transform>().setScale(glm::vec3(0.5f));
+    prefab.addComponent<cro::Sprite>() = spriteSheet.getSprite("bullet");
+
+    auto entities = scene.instantiate(prefab, 100);
+    for (auto e : entities)
+    {
+        //set any properties unique to each entity
+    }
+    \endcode
+    Components are copied as they are, so care should be taken with components
+    which reference other entities, such as a Transform with a parent.
+    */
+    class Prefab final
+    {
+    public:
+        Prefab() = default;
+        ~Prefab() = default;
+
+        Prefab(const Prefab&) = delete;
+        Prefab(Prefab&&) = default;
+        Prefab& operator = (const Prefab&) = delete;
+        Prefab& operator = (Prefab&&) = default;
+
+        /*!
+        \brief Constructs a component of this type from the given parameters.
+        If the Prefab already has a component of this type it is replaced.
+        \returns Reference to the new component
+        */
+        template <typename T, typename... Args>
+        T& addComponent(Args&&... args)
+        {
+            const auto id = Component::getID<T>();
+            CRO_ASSERT(id < m_components.size(), "Component ID out of range");
+
+            auto component = std::make_unique<ComponentData<T>>(std::forward<Args>(args)...);
+            auto& ret = component->component;
+            m_components[id] = std::move(component);
+            m_componentMask.set(id);
+            return ret;
+        }
+
+        /*!
+        \brief Returns true if the Prefab has a component of this type
+        */
+        template <typename T>
+        bool hasComponent() const
+        {
+            return m_componentMask.test(Component::getID<T>());
+        }
+
+        /*!
+        \brief Returns a reference to the component of this type
+        */
+        template <typename T>
+        T& getComponent()
+        {
+            CRO_ASSERT(hasComponent<T>(), "Component does not exist!");
+            return static_cast<ComponentData<T>*>(m_components[Component::getID<T>()].get())->component;
+        }
+
+        /*!
+        \brief Returns the mask of components which make up this Prefab
+        */
+        const ComponentMask& getComponentMask() const { return m_componentMask; }
+
+    private:
+        struct ComponentBase
+        {
+            virtual ~ComponentBase() = default;
+            virtual void copyTo(EntityManager&, const std::vector<Entity>&) const = 0;
+        };
+
+        template <typename T>
+        struct ComponentData final : public ComponentBase
+        {
+            template <typename... Args>
+            explicit ComponentData(Args&&... args) : component(std::forward<Args>(args)...) {}
+
+            void copyTo(EntityManager& em, const std::vector<Entity>& entities) const override
+            {
+                auto& pool = em.getComponentPool<T>();
+                pool.reserve(pool.size() + entities.size());
+
+                //the component masks are updated by the EntityManager
+                for (auto entity : entities)
+                {
+                    pool.insert(entity.getIndex(), T(component));
+                }
+            }
+
+            T component;
+        };
+
+        std::array<std::unique_ptr<ComponentBase>, Detail::MaxComponents> m_components = {};
+        ComponentMask m_componentMask;
+
+        //copies each component type on to all of the given entities
+        void copyComponents(EntityManager& em, const std::vector<Entity>& entities) const
+        {
+            for (const auto& c : m_components)
+            {
+                if (c)
+                {
+                    c->copyTo(em, entities);
+                }
+            }
+        }
+
+        friend class EntityManager;
+    };
+}
@@ -33,6 +33,8 @@ source distribution.
 #include <crogine/core/App.hpp>
 #include <crogine/ecs/Entity.hpp>
 #include <crogine/ecs/System.hpp>
+#include <crogine/ecs/View.hpp>
+#include <crogine/ecs/Prefab.hpp>
 #include <crogine/ecs/systems/CommandSystem.hpp>
 #include <crogine/ecs/Director.hpp>
 #include <crogine/ecs/Sunlight.hpp>
@@ -61,7 +63,14 @@ namespace cro
     class CRO_EXPORT_API Scene final
     {
     public:
-        explicit Scene(MessageBus&);
+        /*!
+        \brief Constructor.
+        \param mb Reference to the system message bus
+        \param initialCapacity Storage is reserved for this many entities
+        when the Scene is created. Scenes which are expected to contain
+        many entities can set this to avoid reallocation.
+        */
+        explicit Scene(MessageBus& mb, std::size_t initialCapacity = Detail::DefaultEntityCapacity);
 
         ~Scene() = default;
         Scene(const Scene&) = delete;
@@ -71,6 +80,10 @@ namespace cro
 
         /*!
         \brief Executes one simulations step.
+        Before any systems are processed, newly created entities are
+        added to systems, entities which have had components added or
+        removed since the last step are moved in to or out of the relevant
+        systems, and destroyed entities are removed.
         \param dt The time elapsed since the last simulation step
         */
         void simulate(Time dt);
@@ -81,10 +94,26 @@ namespace cro
         Entity createEntity();
 
         /*!
-        \brief Destroys the given entity and removes it from the scene
+        \brief Destroys the given entity and removes it from the scene.
+        The entity's components are released at the beginning of the next
+        simulate(), which may move the components of other entities within
+        their pools. Any references to components held at that point are
+        invalidated, see Entity::getComponent().
         */
         void destroyEntity(Entity);
 
+        /*!
+        \brief Creates the given number of entities, each with a copy of
+        the components in the given Prefab.
+        Each component type is copied in to its pool for all of the
+        entities at once and each entity's component mask is set once.
+        The entities are added to systems together at the beginning of
+        the next simulate().
+        \returns A list of the new entities
+        \see Prefab
+        */
+        std::vector<Entity> instantiate(const Prefab&, std::size_t count = 1);
+
         /*|
         \brief Returns the entity with the given ID if it exists
         */
@@ -106,6 +135,32 @@ namespace cro
         template <typename T>
         T& getSystem();
 
+        /*!
+        \brief Returns true if a system of this type exists in the Scene
+        */
+        template <typename T>
+        bool hasSystem() const;
+
+        /*!
+        \brief Returns the pool containing every component of the given type
+        in this Scene. Components are packed contiguously so systems which
+        only need to touch a single component type can iterate the pool
+        directly rather than looking components up through each Entity.
+        Adding or releasing components reorders the pool, so iterators and
+        references into it are invalidated by addComponent() and by the next
+        simulate().
+        */
+        template <typename T>
+        Detail::ComponentPool<T>& getComponentPool();
+
+        /*!
+        \brief Returns a View of all the entities in the Scene which have
+        every one of the given component types.
+        \see View
+        */
+        template <typename... Ts>
+        View<Ts...> view();
+
         /*!
         \brief Adds a Director to the Scene.
         Directors are used to control in game entities and events through
@@ -190,10 +245,20 @@ namespace cro
         void forwardEvent(const Event&);
 
         /*!
-        \brief Forwards messages to the systems in the scene
+        \brief Forwards messages to the systems in the scene.
+        Messages are only passed to systems and directors which
+        handle them, and which have subscribed to the message ID
+        if they have any subscriptions.
         */
         void forwardMessage(const Message&);
 
+        /*!
+        \brief Returns the number of times a message was passed to a
+        system or director in the frame before the last call to simulate().
+        Useful for profiling message traffic.
+        */
+        std::size_t getDeliveredMessageCount() const { return m_lastDeliveredCount; }
+
         /*!
         \brief Draws any renderable systems in this scene, in the order in which they were addeded
         */
@@ -218,6 +283,8 @@ namespace cro
         SystemManager m_systemManager;
 
         std::vector<std::unique_ptr<Director>> m_directors;
+        std::size_t m_deliveredCount;
+        std::size_t m_lastDeliveredCount;
 
         std::vector<Renderable*> m_renderables;
 
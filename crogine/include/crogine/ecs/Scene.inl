@@ -45,6 +45,24 @@ T& Scene::getSystem()
     return m_systemManager.getSystem<T>();
 }
 
+template <typename T>
+bool Scene::hasSystem() const
+{
+    return m_systemManager.hasSystem<T>();
+}
+
+template <typename T>
+Detail::ComponentPool<T>& Scene::getComponentPool()
+{
+    return m_entityManager.getComponentPool<T>();
+}
+
+template <typename... Ts>
+View<Ts...> Scene::view()
+{
+    return View<Ts...>(m_entityManager, m_entityManager.getComponentPool<Ts>()...);
+}
+
 template <typename T, typename... Args>
 T& Scene::addDirector(Args&&... args)
 {
@@ -36,11 +36,19 @@ source distribution.
 
 #include <vector>
 #include <typeindex>
+#include <limits>
+#include <cstdint>
 
 namespace cro
 {
     class Time;
     class Scene;
+    class SystemManager;
+
+    namespace Detail
+    {
+        class SystemScheduler;
+    }
 
     using UniqueType = std::type_index;
 
@@ -56,6 +64,16 @@ namespace cro
 
         using Ptr = std::unique_ptr<System>;
 
+        /*!
+        \brief Describes how a System accesses a component type.
+        Used by the SystemManager to decide which systems may be
+        processed concurrently.
+        */
+        enum class Access
+        {
+            Read, ReadWrite
+        };
+
         /*!
         \brief Constructor.
         Pass in a reference to the concrete implementation to generate
@@ -63,7 +81,7 @@ namespace cro
         */
         //template <typename T>
         System(MessageBus& mb, UniqueType t) 
-            : m_messageBus(mb), m_type(t), m_scene(nullptr){}
+            : m_messageBus(mb), m_type(t), m_parallel(false), m_handlesMessages(true), m_scene(nullptr), m_systemManager(nullptr){}
 
         virtual ~System() = default;
 
@@ -83,7 +101,9 @@ namespace cro
         void addEntity(Entity);
 
         /*!
-        \brief Removes an entity from the list to process
+        \brief Removes an entity from the list to process.
+        This is done in constant time by swapping the entity with the
+        last in the list, so the order of the list is not preserved.
         */
         void removeEntity(Entity);
 
@@ -94,10 +114,38 @@ namespace cro
         const ComponentMask& getComponentMask() const;
 
         /*!
-        \brief Used to process any incoming system messages
+        \brief Returns a mask of all the component types this system
+        reads or writes when processing.
+        */
+        const ComponentMask& getReadMask() const { return m_readMask; }
+
+        /*!
+        \brief Returns a mask of all the component types this system
+        may modify when processing.
+        */
+        const ComponentMask& getWriteMask() const { return m_writeMask; }
+
+        /*!
+        \brief Returns true if this system may be processed on a worker thread
+        concurrently with other systems.
+        \see setParallel()
+        */
+        bool isParallel() const { return m_parallel; }
+
+        /*!
+        \brief Used to process any incoming system messages.
+        Systems which override this receive every message unless they
+        declare the message IDs they are interested in via subscribe().
+        Systems which don't override it receive no messages at all.
         */
         virtual void handleMessage(const cro::Message&);
 
+        /*!
+        \brief Returns the list of message IDs this system has subscribed to.
+        An empty list means the system receives every message.
+        */
+        const std::vector<Message::ID>& getSubscriptions() const { return m_subscriptions; }
+
         /*!
         \brief Implement this for system specific processing to entities.
         */
@@ -108,12 +156,56 @@ namespace cro
         /*!
         \brief Adds a component type to the list of components required by the
         system for it to be interested in a particular entity.
+        \param access Declares whether the system modifies this component type
+        when processing. Components are assumed to be modified unless declared
+        otherwise.
         */
         template <typename T>
-        void requireComponent();
+        void requireComponent(Access access = Access::ReadWrite);
+
+        /*!
+        \brief Declares that the system accesses components of this type when
+        processing, without requiring them. For example a system may read the
+        Transform of a Scene's active camera. Declarations accumulate: once
+        ReadWrite access to a type has been declared, a later declaration
+        of Read access does not revoke it.
+        */
+        template <typename T>
+        void accessComponent(Access access);
+
+        /*!
+        \brief Allows this system to be processed on a worker thread.
+        Parallel systems are run concurrently with other parallel systems
+        whose declared component access does not conflict, while the relative
+        order of conflicting systems is preserved. Systems which are not
+        parallel (the default) are always run on the main thread in the order
+        in which they were added, after any preceding systems have finished.
+        A parallel system must declare every component type it accesses,
+        and must not post messages, create or destroy entities or make any
+        OpenGL calls from process().
+        */
+        void setParallel(bool parallel) { m_parallel = parallel; }
+
+        /*!
+        \brief Registers interest in messages of the given ID.
+        Once a system has subscribed to at least one ID only messages
+        with a subscribed ID are passed to handleMessage(). Like
+        requireComponent() this is usually called from the constructor,
+        though systems may subscribe to further IDs at any time.
+        */
+        void subscribe(Message::ID id);
 
         std::vector<Entity>& getEntities() { return m_entities; }
 
+        /*!
+        \brief Systems which reorder the list returned by getEntities(),
+        for example by sorting it, must call this afterwards so that their
+        entities can still be found when they are removed.
+        This is O(n) in the number of entities, so should only be called
+        once the list has been reordered, rather than every frame.
+        */
+        void entitiesReordered();
+
         /*!
         \brief Optional callback performed when an entity is added
         */
@@ -151,9 +243,21 @@ namespace cro
         UniqueType m_type;
 
         ComponentMask m_componentMask;
+        ComponentMask m_readMask;
+        ComponentMask m_writeMask;
+        bool m_parallel;
         std::vector<Entity> m_entities;
 
+        std::vector<Message::ID> m_subscriptions;
+        bool m_handlesMessages;
+
+        //position of each entity in m_entities, by entity index
+        static constexpr std::uint32_t NullIndex = std::numeric_limits<std::uint32_t>::max();
+        std::vector<std::uint32_t> m_entityIndices;
+        bool contains(Entity::ID);
+
         Scene* m_scene;
+        SystemManager* m_systemManager;
 
         friend class SystemManager;
     };
@@ -163,7 +267,7 @@ namespace cro
     public:
         explicit SystemManager(Scene&);
 
-        ~SystemManager() = default;
+        ~SystemManager();
         SystemManager(const SystemManager&) = delete;
         SystemManager(const SystemManager&&) = delete;
         SystemManager& operator = (const SystemManager&) = delete;
@@ -207,17 +311,57 @@ namespace cro
         void removeFromSystems(Entity);
 
         /*!
-        \brief Forwards messages to all systems
+        \brief Submits a batch of entities to all available systems.
+        This is preferable to calling addToSystems() for each entity
+        as each system's mask and entity list are only visited once.
+        */
+        void addToSystems(const std::vector<Entity>&);
+
+        /*!
+        \brief Removes a batch of entities from any systems to which they may belong
+        */
+        void removeFromSystems(const std::vector<Entity>&);
+
+        /*!
+        \brief Adds or removes each of the given entities to or from
+        any systems whose required components it has gained or lost.
+        Only systems whose interest in an entity has changed are affected.
         */
-        void forwardMessage(const cro::Message&);
+        void updateSystems(const std::vector<Entity>&);
 
         /*!
-        \brief Runs a simulation step by calling process() on each system
+        \brief Forwards messages to all systems which have
+        subscribed to the message ID, in the order in which the
+        systems were added.
+        \returns The number of systems to which the message was delivered
+        */
+        std::size_t forwardMessage(const cro::Message&);
+
+        /*!
+        \brief Runs a simulation step by calling process() on each system.
+        Systems marked as parallel may be processed concurrently on worker
+        threads, according to their declared component access.
         */
         void process(Time);
     private:
         Scene& m_scene;
         std::vector<std::unique_ptr<System>> m_systems;
+
+        std::unique_ptr<Detail::SystemScheduler> m_scheduler;
+        bool m_scheduleDirty;
+
+        //systems which receive each message ID, built the first time the ID is seen
+        struct MessageRoute final
+        {
+            bool built = false;
+            std::vector<System*> systems;
+        };
+        std::vector<MessageRoute> m_messageRoutes;
+
+        //called when a system subscribes after its routes may have been built
+        void subscriptionAdded(const System&, Message::ID);
+
+        friend class System;
     };
 
 #include "System.inl"
@@ -28,10 +28,25 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 template <typename T>
-void System::requireComponent()
+void System::requireComponent(Access access)
 {
     const auto id = Component::getID<T>();
     m_componentMask.set(id);
+    accessComponent<T>(access);
+}
+
+template <typename T>
+void System::accessComponent(Access access)
+{
+    const auto id = Component::getID<T>();
+    m_readMask.set(id);
+
+    //write access is never revoked, so a later declaration
+    //of read access can't hide a writer from the scheduler
+    if (access == Access::ReadWrite)
+    {
+        m_writeMask.set(id);
+    }
 }
 
 template <typename T>
@@ -46,6 +46,12 @@ T& SystemManager::addSystem(Args&&... args)
 
     m_systems.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
     m_systems.back()->setScene(m_scene);
+    m_systems.back()->m_systemManager = this;
+    m_scheduleDirty = true;
+
+    //systems which don't override handleMessage() need never be sent messages
+    m_systems.back()->m_handlesMessages = !std::is_same<decltype(&T::handleMessage), void (System::*)(const Message&)>::value;
+    m_messageRoutes.clear();
     return *(dynamic_cast<T*>(m_systems.back().get()));
 }
 
@@ -58,6 +64,8 @@ void SystemManager::removeSystem()
     {
         return sys->getType() == type;
     }), std::end(m_systems));
+    m_scheduleDirty = true;
+    m_messageRoutes.clear();
 }
 
 template <typename T>
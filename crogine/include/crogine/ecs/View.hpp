@@ -0,0 +1,183 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/ecs/Entity.hpp>
+
+#include <tuple>
+#include <vector>
+#include <limits>
+#include <type_traits>
+
+namespace cro
+{
+    /*!
+    \brief Provides typed iteration over every entity which has all of the given
+    component types.
+    Rather than visiting a System's entity list and calling getComponent() for
+    each type, a View walks the smallest of the requested component pools and
+    resolves the remaining components directly by entity index. Views are
+    lightweight and should be created where they are used, via Scene::view().
+    \code
+    for (auto [tx, model] : getScene()->view<Transform, Model>())
+    {
+        //do stuff with tx and model
+    }
+
+    getScene()->view<Transform, Model>().each([](Entity e, Transform& tx, Model& model)
+    {
+        //the entity is optional in the callback signature
+    });
+    \endcode
+    Note that Views read the component pools directly, so entities are included
+    as soon as they have the required components, rather than when they are
+    added to Systems at the beginning of the next Scene::simulate(). This
+    includes entities which were created or destroyed this frame, until the
+    Scene is next simulated. Removed components are excluded immediately, even
+    though their data remains in the pool until the Scene is next simulated.
+    Adding or removing components of the viewed types while iterating a View
+    is undefined.
+    */
+    template <typename... Ts>
+    class View final
+    {
+        static_assert(sizeof...(Ts) > 0, "Views require at least one component type");
+
+    public:
+        class Iterator final
+        {
+        public:
+            Iterator(const View* view, std::size_t position)
+                : m_view(view), m_position(position)
+            {
+                skipInvalid();
+            }
+
+            std::tuple<Ts&...> operator * () const
+            {
+                return m_view->get((*m_view->m_indices)[m_position]);
+            }
+
+            Iterator& operator ++ ()
+            {
+                ++m_position;
+                skipInvalid();
+                return *this;
+            }
+
+            bool operator == (const Iterator& other) const { return m_position == other.m_position; }
+            bool operator != (const Iterator& other) const { return m_position != other.m_position; }
+
+            /*!
+            \brief Returns the index of the entity the iterator currently points to
+            */
+            std::uint32_t getEntityIndex() const { return (*m_view->m_indices)[m_position]; }
+
+        private:
+            const View* m_view;
+            std::size_t m_position;
+
+            void skipInvalid()
+            {
+                while (m_position < m_view->m_indices->size()
+                    && !m_view->containsAll((*m_view->m_indices)[m_position]))
+                {
+                    ++m_position;
+                }
+            }
+        };
+
+        View(EntityManager& em, Detail::ComponentPool<Ts>&... pools)
+            : m_entityManager   (em),
+            m_pools             (&pools...),
+            m_indices           (nullptr)
+        {
+            (m_mask.set(Component::getID<Ts>()), ...);
+
+            //iterate the smallest pool
+            std::size_t smallest = std::numeric_limits<std::size_t>::max();
+            ((pools.size() < smallest ? (smallest = pools.size(), m_indices = &pools.getEntityIndices()) : m_indices), ...);
+        }
+
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, m_indices->size()); }
+
+        /*!
+        \brief Calls the given function for each entity in the view.
+        The function may have the signature void(Ts&...) or void(Entity, Ts&...)
+        */
+        template <typename Func>
+        void each(Func&& func) const
+        {
+            const auto& indices = *m_indices;
+            for (auto i = 0u; i < indices.size(); ++i)
+            {
+                const auto idx = indices[i];
+                if (containsAll(idx))
+                {
+                    if constexpr (std::is_invocable_v<Func, Entity, Ts&...>)
+                    {
+                        func(m_entityManager.getEntity(idx), std::get<Detail::ComponentPool<Ts>*>(m_pools)->at(idx)...);
+                    }
+                    else
+                    {
+                        func(std::get<Detail::ComponentPool<Ts>*>(m_pools)->at(idx)...);
+                    }
+                }
+            }
+        }
+
+        /*!
+        \brief Returns the upper bound of the number of entities in the view.
+        This is the size of the smallest pool, some of which may not contain
+        all of the requested components.
+        */
+        std::size_t sizeHint() const { return m_indices->size(); }
+
+    private:
+        EntityManager& m_entityManager;
+        std::tuple<Detail::ComponentPool<Ts>*...> m_pools;
+        const std::vector<std::uint32_t>* m_indices;
+        ComponentMask m_mask;
+
+        bool containsAll(std::uint32_t idx) const
+        {
+            //removed components stay in their pool until the removal is flushed,
+            //but are cleared from the entity's mask straight away
+            return (std::get<Detail::ComponentPool<Ts>*>(m_pools)->contains(idx) && ...)
+                && (m_entityManager.getComponentMask(m_entityManager.getEntity(idx)) & m_mask) == m_mask;
+        }
+
+        std::tuple<Ts&...> get(std::uint32_t idx) const
+        {
+            return std::tuple<Ts&...>(std::get<Detail::ComponentPool<Ts>*>(m_pools)->at(idx)...);
+        }
+    };
+}
@@ -30,15 +30,14 @@ source distribution.
 #pragma once
 
 #include <crogine/Config.hpp>
-
-#include <functional>
+#include <crogine/core/Function.hpp>
 
 namespace cro
 {
     class Entity;
     class Time;
 
-    using CallbackFunction = std::function<void(Entity, Time)>;
+    using CallbackFunction = cro::Function<void(Entity, Time)>;
     /*!
     \brief Allows attaching a callback function to an entity.
     \see CallbackSystem
@@ -48,6 +48,8 @@ namespace cro
 
     The command target system will then apply any given commands to targets
     whose flags match one or more of the flags belonging to the command.
+    If the ID is modified after the entity has been added to the Scene
+    CommandSystem::updateTarget() should be called with the entity.
     \see CommandSystem
     */
     struct CRO_EXPORT_API CommandTarget final
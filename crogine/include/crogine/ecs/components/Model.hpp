@@ -93,6 +93,10 @@ namespace cro
     private:
         bool m_visible = false;
 
+        //world space bounds, cached if the model has a static transform
+        Sphere m_worldBounds;
+        bool m_boundsCached = false;
+
         Mesh::Data m_meshData;
         std::array<Material::Data, Mesh::IndexData::MaxBuffers> m_materials{};       
         std::array<Material::Data, Mesh::IndexData::MaxBuffers> m_shadowMaterials{};
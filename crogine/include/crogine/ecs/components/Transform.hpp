@@ -37,23 +37,23 @@ source distribution.
 #include <crogine/detail/glm/mat4x4.hpp>
 #include <crogine/detail/glm/gtc/quaternion.hpp>
 
-#include <array>
 #include <vector>
 
 namespace cro
 {
     class Entity;
+    namespace Detail
+    {
+        template <class T>
+        class ComponentPool;
+    }
+
     /*!
     \brief A three dimensional transform component
     */
     class CRO_EXPORT_API Transform final
     {
     public:
-        enum
-        {
-            MaxChildren = 16
-        };
-
         /*!
         TODO this needs to be non-copyable at the least
         probably with special move operator to account for
@@ -108,10 +108,33 @@ namespace cro
         glm::vec3 getPosition() const;
 
         /*!
-        \brief Returns the world position of the transform
+        \brief Returns the world position of the transform.
+        For parented transforms this is cached by the SceneGraph
+        when the world transform is updated. If the parent was set
+        since the SceneGraph last ran it is calculated from the parent.
         */
         glm::vec3 getWorldPosition() const;
 
+        /*!
+        \brief Returns the world rotation of the transform, including
+        the rotation of any parents. Cached by the SceneGraph for
+        parented transforms, see getWorldPosition().
+        */
+        glm::quat getWorldRotation() const;
+
+        /*!
+        \brief Returns the scale of the world transform along each of
+        its axes. Cached by the SceneGraph for parented transforms,
+        see getWorldPosition().
+        */
+        glm::vec3 getWorldScale() const;
+
+        /*!
+        \brief Returns the largest of the world scale axes, useful for
+        scaling bounding volumes into world space.
+        */
+        float getMaxWorldScale() const;
+
         /*!
         \brief Returns the euler rotation of the transform
         */
@@ -132,7 +155,9 @@ namespace cro
         const glm::mat4& getLocalTransform() const;
         /*!
         \brief Returns a matrix representing the world space Transform.
-        This is the local transform multiplied by all parenting transforms
+        This is the local transform multiplied by all parenting transforms.
+        This never modifies the Transform, so it is safe to call from
+        systems which only declare read access to Transform components.
         */
         glm::mat4 getWorldTransform() const;
 
@@ -156,9 +181,34 @@ namespace cro
         int32 getParentID() const { return m_parent; }
 
         /*!
-        \brief Returns a read-only list of child IDs
+        \brief Returns a read-only list of child IDs, sorted by
+        descending entity ID and terminated with -1, so it always
+        contains at least one element. There is no limit on the number
+        of children a transform may have. The hierarchy is updated by
+        the SceneGraph, so children added or removed this frame will
+        appear once the SceneGraph has been processed. The list is
+        built and cached the first time it is requested after the
+        children change, so systems calling this from a parallel
+        process() should declare write access to Transform.
         */
-        const std::array<int32, MaxChildren>& getChildIDs() const { return m_children; }
+        const std::vector<int32>& getChildIDs() const;
+
+        /*!
+        \brief Marks this transform as static, for geometry which never moves.
+        Once the SceneGraph has calculated the world transform of a static
+        transform it is no longer checked for changes each frame, and other
+        systems may cache data derived from it, such as world bounds.
+        This should be set when the component is created, before the entity
+        is added to the Scene. To change it afterwards remove the Transform
+        component and add it again. Static transforms which are parented to
+        a non-static transform are treated as non-static.
+        */
+        void setStatic(bool isStatic) { m_static = isStatic; }
+
+        /*!
+        \brief Returns true if this transform was marked as static
+        */
+        bool isStatic() const { return m_static; }
 
     private:
         glm::vec3 m_origin;
@@ -167,35 +217,36 @@ namespace cro
         glm::quat m_rotation;
         mutable glm::mat4 m_transform;
         mutable glm::mat4 m_worldTransform;
+        glm::vec3 m_worldPosition;
+        glm::quat m_worldRotation;
+        glm::vec3 m_worldScale;
 
         int32 m_parent;
-        int32 m_lastParent;
         int32 m_id;
-        std::array<int32, MaxChildren> m_children = {};
-        std::vector<int32> m_removedChildren;
+        Entity m_parentEntity; //as passed to setParent(), until the SceneGraph links it
+
+        //the hierarchy is stored as intrusive links maintained by the SceneGraph
+        int32 m_linkedParent; //parent to which this node is currently linked, which m_parent may not yet match
+        int32 m_firstChild;
+        int32 m_nextSibling;
+        int32 m_previousSibling;
+        const Detail::ComponentPool<Transform>* m_pool; //pool holding the linked children
+        mutable std::vector<int32> m_childIDs; //built on request by getChildIDs()
+
+        bool m_static;
 
         enum Flags
         {
             Parent = 0x1,
-            Child = 0x2,
+            Child = 0x2, //m_childIDs needs rebuilding
             Tx = 0x4,
             All = Parent | Child | Tx
         };
         mutable uint8 m_dirtyFlags;
 
-        friend class SceneGraph;
-
-        /*!
-        \brief Sets the child node at the given index.
-        \param id ID of the entity to add as a child.
-        No more than MaxChildren may be added to any one transform.
-        \returns false if child was not successfully added
-        */
-        bool addChild(uint32 id);
+        bool linkPending() const { return m_parent > -1 && m_parent != m_linkedParent; }
+        glm::mat4 getPendingWorldTransform() const;
 
-        /*!
-        \brief Removes a child with the given entity ID if it exists.
-        */
-        void removeChild(uint32 id);
+        friend class SceneGraph;
     };
 }
\ No newline at end of file
@@ -38,7 +38,7 @@ source distribution.
 #include <btBulletCollisionCommon.h>
 
 #include <memory>
-#include <array>
+#include <vector>
 #include <unordered_map>
 
 namespace cro
@@ -81,10 +81,10 @@ namespace cro
             btCollisionShape* shape = nullptr;
             std::unique_ptr<btCollisionObject> object;
         };
-        std::array<CollisionData, Detail::MinFreeIDs> m_collisionData;
+        std::vector<CollisionData> m_collisionData; //indexed by entity, grows as needed
         //std::vector<std::unique_ptr<btCollisionShape>> m_shapeCache;
         std::unordered_map<std::size_t, std::unique_ptr<btCollisionShape>> m_shapeCache;
-        std::array<std::unique_ptr<btCompoundShape>, Detail::MinFreeIDs> m_compoundShapes;
+        std::vector<std::unique_ptr<btCompoundShape>> m_compoundShapes;
 
         Detail::BulletDebug m_debugDrawer;
     };
@@ -30,25 +30,31 @@ source distribution.
 #pragma once
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/core/Function.hpp>
 
-#include <functional>
+#include <array>
 
 namespace cro
 {
     /*!
     \brief Command struct.
     Each command encapsulates a mask of target IDs
-    as well as a command in the form of a std::function
+    as well as a command in the form of a cro::Function.
+    Commands with small captures can be created and sent
+    without allocating any memory.
     */
     struct CRO_EXPORT_API Command final
     {
         uint32 targetFlags = 0;
-        std::function<void(Entity, Time)> action;
+        cro::Function<void(Entity, Time)> action;
     };
 
     /*
     \brief The command system is used to execute commands which are
-    targetted at specific IDs
+    targetted at specific IDs.
+    Entities are sorted into a bucket for each bit of their CommandTarget
+    ID, so each command only visits entities with a matching flag,
+    rather than testing every entity against every command.
     */
     class CRO_EXPORT_API CommandSystem final : public cro::System
     {
@@ -59,11 +65,27 @@ namespace cro
         \brief Places a command on the command queue.
         Each frame the entire queue is processed and cleared,
         executing each command on each entity with a matching
-        CommandTarget flag.
+        CommandTarget flag. Commands sent from within another
+        command are executed on the following frame.
         \see CommandTarget
         */
         void sendCommand(const Command&);
 
+        /*!
+        \brief Moves a command on to the command queue.
+        \see sendCommand(const Command&)
+        */
+        void sendCommand(Command&&);
+
+        /*!
+        \brief Updates the targets of an entity whose CommandTarget ID
+        was modified after the entity was added to the Scene.
+        The ID is read when the entity is added, so this is only needed
+        when the ID is changed at run time. The new ID takes effect
+        from the next time commands are executed.
+        */
+        void updateTarget(Entity);
+
         /*!
         \brief Process override
         */
@@ -71,7 +93,31 @@ namespace cro
 
     private:
         std::vector<Command> m_commands;
-        std::vector<Command>::iterator m_currentCommand;
-        std::size_t m_count;
+        std::vector<Command> m_activeCommands;
+
+        //entities for each bit of the CommandTarget ID
+        std::array<std::vector<Entity>, 32u> m_buckets;
+        uint32 m_dirtyBuckets; //buckets which may contain entities to be removed
+
+        //the ID each entity is currently bucketed with, by entity index
+        struct Target final
+        {
+            uint32 id = 0;
+            Entity::Generation generation = 0;
+            bool active = false;
+        };
+        std::vector<Target> m_targets;
+        std::vector<Entity> m_changedTargets;
+
+        //prevents commands with multiple flags visiting an entity twice
+        std::vector<uint32> m_visitStamps;
+        uint32 m_currentStamp;
+
+        void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
+
+        void refreshTargets();
+        void addToBuckets(Entity, uint32);
+        bool isTarget(Entity, uint32) const;
     };
 }
\ No newline at end of file
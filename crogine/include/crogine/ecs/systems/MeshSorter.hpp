@@ -65,7 +65,9 @@ namespace cro
     private:
 
         SceneRenderer& m_renderer;
-        MaterialList m_visibleEntities;
+        //both are cleared rather than released each frame
+        std::vector<std::pair<uint64, DrawItem>> m_sortItems;
+        DrawList m_drawList;
     };
 }
 
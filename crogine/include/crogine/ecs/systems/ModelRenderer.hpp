@@ -34,24 +34,31 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/MaterialData.hpp>
+#include <crogine/graphics/RenderState.hpp>
 #include <crogine/detail/SDLResource.hpp>
 
+#include <crogine/detail/glm/mat3x3.hpp>
+#include <crogine/detail/glm/mat4x4.hpp>
+
 #include <vector>
 
 namespace cro
 {
     class MessageBus;
     class Model;
+    struct Camera;
 
     //don't export this, used internally.
-    struct SortData final
+    //a single submesh of a visible model
+    struct DrawItem final
     {
-        int64 flags = 0;
-        std::vector<int32> matIDs;
+        Entity entity;
+        uint32 submesh = 0;
     };
 
-    using MaterialPair = std::pair<Entity, SortData>;
-    using MaterialList = std::vector<MaterialPair>;
+    //rebuilt each frame, but only cleared so that its
+    //memory is reused once it has grown large enough
+    using DrawList = std::vector<DrawItem>;
 
 
     /*!
@@ -59,6 +66,11 @@ namespace cro
     The system frustum-culls then renders any entities with a Model component
     in the scene. Note this only renders Models - Sprite and Text components
     have their own respective rendering systems.
+    Models which share a mesh and a material whose shader was created with
+    ShaderResource::Instancing (or declares the a_instanceWorldMatrix attribute)
+    are drawn together with a single instanced draw call where the platform
+    supports it. On platforms without instancing, such as OpenGL ES 2, they
+    are drawn one at a time with the same shader.
     */
     class CRO_EXPORT_API ModelRenderer final : public System, public Renderable
     {
@@ -69,6 +81,13 @@ namespace cro
         */
         explicit ModelRenderer(MessageBus& mb);
 
+        ~ModelRenderer();
+
+        ModelRenderer(const ModelRenderer&) = delete;
+        ModelRenderer(ModelRenderer&&) = delete;
+        ModelRenderer& operator = (const ModelRenderer&) = delete;
+        ModelRenderer& operator = (ModelRenderer&&) = delete;
+
         /*!
         \brief Performs frustum culling and Material sorting by depth and blend mode
         */
@@ -80,13 +99,43 @@ namespace cro
         void render(Entity) override;
 
     private:
-        MaterialList m_visibleEntities;
+        DrawList m_drawList;
         //TODO list of lighting
 
+        //sort key and index into the draw list, in draw order
+        std::vector<std::pair<uint64, uint32>> m_drawOrder;
+        std::vector<std::pair<uint64, uint32>> m_sortBuffer;
+
         uint32 m_currentTextureUnit;
+        RenderState m_renderState;
+
+        //shaders which have had their per-pass uniforms set
+        std::vector<uint32> m_passShaders;
+
+        //index of the first item in m_drawOrder and the number of
+        //items drawn with it. Items are only batched when instancing
+        //is supported, else each batch contains a single item.
+        std::vector<std::pair<uint32, uint32>> m_batches;
+
+        struct InstanceData final
+        {
+            glm::mat4 worldMatrix = glm::mat4(1.f);
+            glm::mat3 normalMatrix = glm::mat3(1.f);
+        };
+        bool m_instancingSupported;
+        uint32 m_instanceBuffer;
+        std::vector<InstanceData> m_instanceData;
+
+        bool canInstance(const DrawItem&, const DrawItem&) const;
+        uint32 applyInstanceAttribs(const Material::Data&, std::size_t offset);
+        void applyInstanceValues(const Material::Data&, const glm::mat4&, const glm::mat3&);
+
+        void applyPassUniforms(const Material::Data&, const Camera&, glm::vec3);
         void applyProperties(const Material::Data&, const Model&);
 
         void applyBlendMode(Material::BlendMode);
+
+        void onEntityAdded(Entity) override;
     };
 
 }
\ No newline at end of file
@@ -33,6 +33,7 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 
 #include <crogine/graphics/Shader.hpp>
+#include <crogine/graphics/RenderState.hpp>
 
 #include <vector>
 
@@ -69,6 +70,7 @@ namespace cro
 
         std::size_t m_visibleCount;
         std::vector<Entity> m_visibleSystems;
+        std::vector<uint8> m_emitterVisibility; //not vector<bool> as it's written from multiple threads
         void allocateBuffer();
 
         Shader m_shader;
@@ -85,5 +87,7 @@ namespace cro
             int32 offset = 0;
         };
         std::array<AttribData, 3u> m_attribData;
+
+        RenderState m_renderState;
     };
 }
\ No newline at end of file
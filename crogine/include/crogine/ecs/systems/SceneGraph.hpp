@@ -31,8 +31,21 @@ source distribution.
 
 #include <crogine/ecs/System.hpp>
 
+#include <crogine/detail/glm/vec3.hpp>
+#include <crogine/detail/glm/mat4x4.hpp>
+#include <crogine/detail/glm/gtc/quaternion.hpp>
+
+#include <vector>
+#include <memory>
+
 namespace cro
 {
+    class Transform;
+    namespace Detail
+    {
+        class TransformStore;
+    }
+
     /*!
     \brief System in charge of making sure parent and child
     transforms correctly update each other.
@@ -44,17 +57,123 @@ namespace cro
     entities appear to 'rubber band' slightly when the parent entity
     moves check that this system is the last system added, before any
     rendererable systems.
+    World transforms are updated in a single pass over a flattened,
+    depth sorted list of the hierarchy, so each transform is visited
+    once per frame regardless of how many children share an ancestor.
+    The list is only rebuilt when the hierarchy changes.
+    Children are stored as intrusive links between transforms, so
+    there is no limit to the number of children a transform may
+    have, and parenting is constant time. Destroying an entity also
+    destroys its children on the following frame.
+    Changed local transforms are gathered into a structure of arrays
+    and composed in batches, using SIMD where the platform supports it.
+    Transforms marked as static are only updated when the hierarchy
+    changes, for example when they are added to the scene, and are
+    otherwise skipped each frame.
+    When interpolation is enabled world transforms are blended between
+    the last two simulation steps while the Scene is drawn, so motion
+    remains smooth when the simulation runs at a lower rate than the
+    display.
     */
     class CRO_EXPORT_API SceneGraph final : public System
     {
     public:
         explicit SceneGraph(MessageBus&);
+        ~SceneGraph();
 
         void process(Time) override;
 
-        void handleMessage(const Message&) override;
+        /*!
+        \brief Returns a list of entities whose world transform was
+        updated during the last call to process().
+        Systems which derive data from transforms, such as bounds or
+        positions, can use this to update only what has changed rather
+        than reading every transform each frame. The list is valid until
+        the SceneGraph is next processed, so renderers will see this
+        frame's changes and other systems will see last frame's.
+        */
+        const std::vector<Entity>& getChangedTransforms() const;
+
+        /*!
+        \brief Enables blending of world transforms between the previous and
+        current simulation step when the Scene is rendered, using the alpha
+        value provided by App::getInterpolationAlpha().
+        Each entity's position and scale are interpolated linearly and its
+        rotation spherically, and the world transform is rebuilt from them,
+        so objects don't shrink or shear as they rotate. The world position,
+        rotation and scale returned by a Transform while rendering are the
+        blended values too. This stores two extra sets of local transform
+        values per entity, and is disabled by default.
+        \see App::setTickRate()
+        */
+        void setInterpolationEnabled(bool enabled);
+
+        /*!
+        \brief Returns true if transform interpolation is enabled
+        */
+        bool getInterpolationEnabled() const { return m_interpolate; }
 
     private:
+        //dynamic entity indices sorted by depth, so parents always precede their children
+        std::vector<uint32> m_order;
+        std::vector<uint32> m_staticOrder;
+        std::vector<uint32> m_sortBuffer;
+        std::vector<uint32> m_newEntities;
+        bool m_orderDirty;
+
+        //the frame on which each entity's world transform was last updated, by entity index
+        std::vector<uint32> m_updateStamps;
+        uint32 m_currentStamp;
+
+        //indices of entities whose world transform needs updating
+        std::vector<uint32> m_dirtyNodes;
+        std::unique_ptr<Detail::TransformStore> m_localTransforms;
+
+        std::vector<Entity> m_changedTransforms;
+
+        //children of removed entities, destroyed if the parent entity was
+        std::vector<std::pair<Entity, Entity>> m_orphans;
+
+        //local transforms at the end of the last two steps, by entity index
+        struct LocalTransform final
+        {
+            glm::vec3 position = glm::vec3(0.f);
+            glm::quat rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+            glm::vec3 scale = glm::vec3(1.f);
+            int32 parent = -1; //transforms aren't blended if this changes
+        };
+        bool m_interpolate;
+        bool m_syncPrevious;
+        std::vector<LocalTransform> m_previousTransforms;
+        std::vector<LocalTransform> m_currentTransforms;
+
+        //values replaced with blended ones while rendering
+        struct SavedTransform final
+        {
+            LocalTransform local;
+            glm::mat4 transform = glm::mat4(1.f);
+            glm::mat4 worldTransform = glm::mat4(1.f);
+            glm::vec3 worldPosition = glm::vec3(0.f);
+            glm::quat worldRotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+            glm::vec3 worldScale = glm::vec3(1.f);
+        };
+        std::vector<SavedTransform> m_savedTransforms;
+
         void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
+
+        void updateParent(Detail::ComponentPool<Transform>&, uint32);
+        void updateTransforms(Detail::ComponentPool<Transform>&, const std::vector<uint32>&);
+        bool canParent(Detail::ComponentPool<Transform>&, uint32, int32) const;
+        void link(Detail::ComponentPool<Transform>&, uint32);
+        void unlink(Detail::ComponentPool<Transform>&, uint32);
+        void rebuildOrder(Detail::ComponentPool<Transform>&);
+        void resizeStamps(std::size_t);
+        static void updateWorldValues(Transform&, const Transform&);
+        static LocalTransform getLocal(const Transform&);
+
+        void beginInterpolation(float);
+        void endInterpolation();
+        friend class Scene;
     };
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/RenderTexture.hpp>
+#include <crogine/graphics/RenderState.hpp>
 
 namespace cro
 {
@@ -76,5 +77,7 @@ namespace cro
         RenderTexture m_target;
         std::vector<Entity> m_visibleEntities;
         glm::vec3 m_projectionOffset;
+        RenderState m_renderState;
+        std::vector<uint32> m_passShaders;
     };
 }
\ No newline at end of file
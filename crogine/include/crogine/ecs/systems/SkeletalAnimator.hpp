@@ -32,8 +32,12 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/ecs/components/Skeleton.hpp>
 
+#include <vector>
+
 namespace cro
 {
+    class Model;
+
     /*!
     \brief System used to update any models which have a skeleton component
     */
@@ -45,8 +49,12 @@ namespace cro
         void process(Time) override;
 
     private:
+        //gathered from a View each frame so that it can be split into batches
+        std::vector<std::pair<Skeleton*, const Model*>> m_skeletons;
+
         void onEntityAdded(Entity) override;
 
+        void processSkeleton(Skeleton&, const Model&, Time);
         void interpolate(std::size_t a, std::size_t b, float time, Skeleton& skelteton);
     };
 }
\ No newline at end of file
@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/ecs/Renderable.hpp>
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/graphics/MaterialData.hpp>
+#include <crogine/graphics/RenderState.hpp>
 #include <crogine/detail/SDLResource.hpp>
 #include <crogine/graphics/Rectangle.hpp>
 
@@ -82,11 +83,6 @@ namespace cro
         */
         DepthAxis getDepthAxis() const { return m_depthAxis; }
 
-        /*!
-        \brief Implements message handling
-        */
-        void handleMessage(const Message&) override;
-
         /*!
         \brief Implements the process which performs batching
         */
@@ -134,6 +130,7 @@ namespace cro
         void rebuildBatch();
 
         void updateGlobalBounds(Sprite&, const glm::mat4&);
+        RenderState m_renderState;
         void applyBlendMode(Material::BlendMode);
 
         void onEntityAdded(Entity) override;
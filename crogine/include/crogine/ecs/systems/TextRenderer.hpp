@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/graphics/Rectangle.hpp>
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/graphics/MaterialData.hpp>
+#include <crogine/graphics/RenderState.hpp>
 #include <crogine/detail/SDLResource.hpp>
 
 #include <crogine/detail/glm/mat4x4.hpp>
@@ -59,11 +60,6 @@ namespace cro
         const TextRenderer& operator = (const TextRenderer&) = delete;
         TextRenderer& operator = (TextRenderer&&) = delete;
 
-        /*!
-        \brief Message handler
-        */
-        void handleMessage(const Message&) override;
-        
         /*!
         \brief Processes the text data into renderable batches
         */
@@ -118,6 +114,7 @@ namespace cro
         void rebuildBatch();
         void updateVerts(Text&);
 
+        RenderState m_renderState;
         void applyBlendMode(Material::BlendMode);
         void applyScissor(const FloatRect&, const glm::mat4&);
 
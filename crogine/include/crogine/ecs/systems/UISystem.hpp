@@ -30,12 +30,11 @@ source distribution.
 #pragma once
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/core/Function.hpp>
 #include <crogine/graphics/Rectangle.hpp>
 
 #include <crogine/detail/glm/mat4x4.hpp>
 
-#include <functional>
-
 namespace cro
 {
     class CRO_EXPORT_API UISystem final : public System
@@ -43,8 +42,8 @@ namespace cro
     public:
         //passes in the entity for whom the callback was triggered and a copy of the flags
         //which contain the input which triggered it. Use the Flags enum to find the input type
-        using ButtonCallback = std::function<void(Entity, uint64 flags)>;
-        using MovementCallback = std::function<void(Entity, glm::vec2)>;
+        using ButtonCallback = cro::Function<void(Entity, uint64 flags)>;
+        using MovementCallback = cro::Function<void(Entity, glm::vec2)>;
 
         explicit UISystem(MessageBus&);
 
@@ -123,21 +123,28 @@ namespace cro
                 Offset
             };
             uint32 shader = 0;
+            //ID of the MaterialResource entry this was created from, used to group draw calls
+            int32 id = 0;
             //maps attrib location to attrib size between shader and mesh - index, size, pointer offset
             std::array<std::array<int32, 3u>, Mesh::Attribute::Total> attribs{}; 
             std::size_t attribCount = 0; //< count of attributes successfully mapped
+            //location of per-instance attributes, or -1 if the shader doesn't support instancing
+            std::array<int32, Mesh::InstanceAttribute::InstanceTotal> instanceAttribs = { -1, -1 };
             //maps uniform locations by indexing via Uniform enum
             std::array<int32, Uniform::Total> uniforms{};
             //optional uniforms are added to this list if they exist
             //for example skinning and projection map data which is
             //used internally, and nor user-definable
             std::size_t optionalUniformCount = 0;
-            std::array<int32, 3> optionalUniforms{};
+            std::array<int32, Uniform::Total> optionalUniforms{};
 
             BlendMode blendMode = BlendMode::None;
 
             //arbitrary uniforms are stored as properties
             PropertyList properties;
+            //combined hash of the property values, updated by setProperty(). Used
+            //to tell whether models' copies of a material can be drawn together
+            uint64 propertyHash = 0;
             /*!
             \brief Sets a float value uniform
             \param name Name of the uniform
@@ -74,6 +74,18 @@ namespace cro
             Total
         };
 
+        /*!
+        \brief used to map per-instance attributes to shader input.
+        These are read from the instance buffer of the ModelRenderer
+        rather than from the mesh
+        */
+        enum InstanceAttribute
+        {
+            InstanceWorldMatrix = 0,
+            InstanceNormalMatrix,
+            InstanceTotal
+        };
+
         /*!
         \brief Index data for sub-mesh
         */
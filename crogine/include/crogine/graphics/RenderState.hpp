@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/detail/Types.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace cro
+{
+    /*!
+    \brief Caches OpenGL state so that calls which would not change
+    anything are skipped.
+    Renderers such as the ModelRenderer hold an instance of this and
+    make all their state changes through it, so that consecutive draw
+    calls which share a shader, buffers, textures or blend state only
+    set them once. As other code may modify the OpenGL state between
+    render passes the cache must be reset at the start of each pass,
+    after which all state is treated as unknown except for the enabled
+    vertex attributes, which are always expected to be disabled between
+    passes.
+    Values are OpenGL enums or handles, stored as integers.
+    */
+    class CRO_EXPORT_API RenderState final
+    {
+    public:
+        enum Capability
+        {
+            Blend, DepthTest, CullFace, ScissorTest,
+
+            CapabilityCount
+        };
+
+        /*!
+        \brief Number of state changes made through all RenderState instances
+        \see getLastFrameStats()
+        */
+        struct Stats final
+        {
+            std::size_t issued = 0; //!< calls which were passed to OpenGL
+            std::size_t skipped = 0; //!< calls which were redundant and skipped
+        };
+
+        RenderState();
+
+        /*!
+        \brief Marks all state as unknown.
+        Call this at the beginning of each render pass.
+        */
+        void reset();
+
+        void useProgram(uint32 program);
+
+        /*!
+        \brief Binds the given buffer to either GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+        */
+        void bindBuffer(uint32 target, uint32 buffer);
+
+        /*!
+        \brief Binds the given texture to GL_TEXTURE_2D on the given texture unit
+        */
+        void bindTexture(uint32 unit, uint32 texture);
+
+        void setCapability(Capability, bool enabled);
+        void setDepthMask(bool enabled);
+        void setCullFace(uint32 face);
+        void setBlendFunc(uint32 source, uint32 destination);
+        void setBlendEquation(uint32 equation);
+
+        /*!
+        \brief Enables the vertex attribute arrays whose bits are set in the
+        given mask and disables any others which are enabled.
+        Pass 0 at the end of a render pass.
+        */
+        void setVertexAttribs(uint32 mask);
+
+        /*!
+        \brief Sets a divisor of 1 on the vertex attributes whose bits are set
+        in the given mask, so that they advance once per instance, and resets
+        any others to 0. Requires instancing support.
+        As with setVertexAttribs() pass 0 at the end of a render pass.
+        */
+        void setAttribDivisors(uint32 mask);
+
+        /*!
+        \brief Returns the number of state changes issued and skipped during the
+        previous frame, by all instances of RenderState.
+        */
+        static Stats getLastFrameStats();
+
+        /*!
+        \brief Used internally by crogine to start counting a new frame
+        */
+        static void endFrame();
+
+    private:
+        static constexpr std::size_t MaxTextureUnits = 16;
+
+        uint32 m_program;
+        uint32 m_arrayBuffer;
+        uint32 m_elementBuffer;
+        uint32 m_activeTextureUnit;
+        std::array<uint32, MaxTextureUnits> m_textures = {};
+        std::array<int32, CapabilityCount> m_capabilities = {};
+        int32 m_depthMask;
+        uint32 m_cullFace;
+        uint32 m_blendSource;
+        uint32 m_blendDestination;
+        uint32 m_blendEquation;
+        uint32 m_vertexAttribs;
+        uint32 m_attribDivisors;
+
+        //checks the cached value and updates it, returning true if the call needs to be made
+        template <typename T>
+        static bool changed(T& current, T value);
+    };
+}
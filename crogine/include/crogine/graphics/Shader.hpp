@@ -91,6 +91,13 @@ namespace cro
         */
         const std::array<int32, Mesh::Attribute::Total>& getAttribMap() const;
 
+        /*!
+        \brief Returns the locations of any per-instance attributes
+        declared by the shader, or -1 if they are not used.
+        \see Mesh::InstanceAttribute
+        */
+        const std::array<int32, Mesh::InstanceAttribute::InstanceTotal>& getInstanceAttribMap() const;
+
         /*!
         \brief Returns a list of active uniforms mapped to their locations
         */
@@ -99,6 +106,7 @@ namespace cro
     private:
         uint32 m_handle;
         std::array<int32, Mesh::Attribute::Total> m_attribMap;
+        std::array<int32, Mesh::InstanceAttribute::InstanceTotal> m_instanceAttribMap;
         bool fillAttribMap();
         void resetAttribMap();
         std::unordered_map<std::string, int32> m_uniformMap;
@@ -64,7 +64,8 @@ namespace cro
             ReceiveProjection = 0x80,
             RimLighting = 0x100,
             DepthMap = 0x200,
-            RxShadows = 0x400
+            RxShadows = 0x400,
+            Instancing = 0x800
         };
         
         ShaderResource();
@@ -101,7 +102,9 @@ namespace cro
         \brief Preloads one of the built in shaders.
         \param type BuiltIn type for shader. Vertex lit supports normal mapping, mask mapping and skinning
         and is lit by in-scene entities which posess lights.
-        \param flags A combination of BuiltInFlags bitwise ORd together indicating which shader features are requested
+        \param flags A combination of BuiltInFlags bitwise ORd together indicating which shader features are requested.
+        Shaders created with the Instancing flag allow the ModelRenderer to draw models which share a mesh and
+        material with a single draw call, where the platform supports it. Instancing cannot be combined with Skinning.
         \returns int32 representing the ID of the preloaded shader if it succeeds, else returns -1. The returned ID
         can be used with get() to return an instance of the shader.
         */
@@ -68,7 +68,7 @@ namespace
         }
     }
 
-    //called in its own thread to update stream buffers
+    //called from the job system to update stream buffers
     int streamUpdate(void* s)
     {
         OpenALStream& stream = *(OpenALStream*)s;
@@ -98,7 +98,6 @@ namespace
             }
         }
 
-        stream.updating = false;
         stream.processed = 0;
 
         return 0;
@@ -285,7 +284,10 @@ cro::int32 OpenALImpl::requestNewStream(const std::string& path)
 void OpenALImpl::updateStream(int32 streamID)
 {
     auto& stream = m_streams[streamID];
-    if (!stream.updating)
+
+    //the counter is only released once the update job has returned
+    //so if it's complete the job has finished with the stream
+    if (stream.counter.complete())
     {
         alCheck(alGetSourcei(stream.sourceID, AL_BUFFERS_PROCESSED, &stream.processed));
         /*ALint queued;
@@ -303,9 +305,7 @@ void OpenALImpl::updateStream(int32 streamID)
 
         if (stream.processed > 0)
         {
-            stream.updating = true;
-            SDL_DetachThread(stream.thread); //make sure to clean up any old threads
-            stream.thread = SDL_CreateThread(streamUpdate, nullptr, &stream);
+            App::getJobSystem().schedule([&stream]() { streamUpdate(&stream); }, &stream.counter);
             //LOG("Processed " + std::to_string(stream.processed) + " buffers", Logger::Type::Info);
         }
     }
@@ -315,14 +315,9 @@ void OpenALImpl::deleteStream(cro::int32 id)
 {
     auto& stream = m_streams[id];
     
-    if (stream.updating)
-    {
-        stream.updating = false;
-        //wait for thread to finish - we have to wait else
-        //we can't be sure it's safe to delete the buffers
-        SDL_WaitThread(stream.thread, nullptr);
-        stream.thread = nullptr;
-    } 
+    //wait for any update job to finish - we have to wait else
+    //we can't be sure it's safe to delete the buffers
+    App::getJobSystem().wait(stream.counter);
 
     if (stream.buffers[0])
     {        
@@ -40,8 +40,7 @@ source distribution.
 #include <AL/alc.h>
 #endif
 
-
-#include <SDL_thread.h>
+#include <crogine/core/JobSystem.hpp>
 
 #include <atomic>
 #include <array>
@@ -55,9 +54,8 @@ namespace cro
             std::array<ALuint, 3> buffers{};
             std::size_t currentBuffer = 0;
             std::unique_ptr<AudioFile> audioFile;
-            std::atomic<bool> updating{ false };
             ALint processed = 0;
-            SDL_Thread* thread = nullptr;
+            JobCounter counter;
             int32 sourceID = -1;
             std::atomic<bool> looped{ false };
             ALenum state = AL_STOPPED;
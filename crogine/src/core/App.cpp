@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/core/ConfigFile.hpp>
 #include <crogine/detail/Assert.hpp>
 #include <crogine/audio/AudioMixer.hpp>
+#include <crogine/graphics/RenderState.hpp>
 #include <crogine/gui/imgui.h>
 
 #include <SDL.h>
@@ -55,7 +56,8 @@ cro::App* App::m_instance = nullptr;
 
 namespace
 {    
-    const Time frameTime = seconds(1.f / 60.f);
+    const float DefaultTickRate = 60.f;
+    const uint32 DefaultMaxCatchUpSteps = 5;
 
 #include "../detail/DefaultIcon.inl"
 
@@ -70,7 +72,11 @@ namespace
 }
 
 App::App()
-    : m_frameClock(nullptr), m_running (false)
+    : m_frameClock      (nullptr),
+    m_running           (false),
+    m_frameTime         (seconds(1.f / DefaultTickRate)),
+    m_maxCatchUpSteps   (DefaultMaxCatchUpSteps),
+    m_interpolationAlpha(1.f)
 {
 	CRO_ASSERT(m_instance == nullptr, "App instance already exists!");
 
@@ -173,16 +179,26 @@ void App::run()
 	{
 		timeSinceLastUpdate += frameClock.restart();
 
-		while (timeSinceLastUpdate > frameTime)
+        auto steps = 0u;
+		while (timeSinceLastUpdate > m_frameTime
+            && steps++ < m_maxCatchUpSteps)
 		{
-			timeSinceLastUpdate -= frameTime;
+			timeSinceLastUpdate -= m_frameTime;
 
             handleEvents();
             handleMessages();
 
-			simulate(frameTime);
+			simulate(m_frameTime);
             //simulate(timeSinceLastUpdate);
 		}
+
+        //if we're still behind drop the remaining time rather than
+        //trying to catch up next frame, which would only make it worse
+        if (timeSinceLastUpdate > m_frameTime)
+        {
+            timeSinceLastUpdate = Time();
+        }
+        m_interpolationAlpha = std::min(1.f, timeSinceLastUpdate.asSeconds() / m_frameTime.asSeconds());
         //DPRINT("Frame time", std::to_string(timeSinceLastUpdate.asMilliseconds()));
         doImGui();
 
@@ -191,8 +207,9 @@ void App::run()
         render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 		m_window.display();
+        RenderState::endFrame();
 
-        //SDL_Delay((frameTime - timeSinceLastUpdate).asMilliseconds());
+        //SDL_Delay((m_frameTime - timeSinceLastUpdate).asMilliseconds());
 	}
 
     saveSettings();
@@ -232,6 +249,12 @@ Window& App::getWindow()
     return m_instance->m_window;
 }
 
+JobSystem& App::getJobSystem()
+{
+    CRO_ASSERT(m_instance, "No valid app instance");
+    return m_instance->m_jobSystem;
+}
+
 const std::string& App::getPreferencePath()
 {
     CRO_ASSERT(m_instance, "No valid app instance");
@@ -244,6 +267,28 @@ void App::resetFrameTime()
     m_frameClock->restart();
 }
 
+void App::setTickRate(float ticksPerSecond)
+{
+    CRO_ASSERT(ticksPerSecond > 0, "Tick rate must be greater than zero");
+    m_frameTime = seconds(1.f / ticksPerSecond);
+}
+
+float App::getTickRate() const
+{
+    return 1.f / m_frameTime.asSeconds();
+}
+
+void App::setMaxCatchUpSteps(uint32 steps)
+{
+    m_maxCatchUpSteps = std::max(1u, steps);
+}
+
+float App::getInterpolationAlpha()
+{
+    CRO_ASSERT(m_instance, "App not initialised");
+    return m_instance->m_interpolationAlpha;
+}
+
 App& App::getInstance()
 {
     CRO_ASSERT(m_instance, "");
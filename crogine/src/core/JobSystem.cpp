@@ -0,0 +1,231 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/core/JobSystem.hpp>
+
+using namespace cro;
+
+namespace
+{
+    //identifies the queue owned by the current thread
+    thread_local const JobSystem* currentSystem = nullptr;
+    thread_local std::size_t currentQueue = 0;
+}
+
+JobSystem::JobSystem(std::size_t threadCount)
+    : m_running     (true),
+    m_queuedCount   (0)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    }
+
+    for (auto i = 0u; i < threadCount + 1; ++i)
+    {
+        m_queues.emplace_back(std::make_unique<Queue>());
+    }
+
+    for (auto i = 0u; i < threadCount; ++i)
+    {
+        m_threads.emplace_back(&JobSystem::threadFunc, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_sleepCondition.notify_all();
+
+    for (auto& t : m_threads)
+    {
+        t.join();
+    }
+}
+
+//public
+void JobSystem::schedule(Job job, JobCounter* counter)
+{
+    if (counter)
+    {
+        counter->m_count++;
+    }
+    push({ std::move(job), counter });
+}
+
+void JobSystem::schedule(Job job, JobCounter& dependency, JobCounter* counter)
+{
+    if (counter)
+    {
+        counter->m_count++;
+    }
+
+    {
+        //the lock makes sure the dependency can't complete between
+        //checking it and adding the continuation
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.complete())
+        {
+            dependency.m_continuations.push_back({ std::move(job), counter });
+            return;
+        }
+    }
+    push({ std::move(job), counter });
+}
+
+void JobSystem::wait(const JobCounter& counter)
+{
+    while (!counter.complete())
+    {
+        JobData data;
+        if (pop(data))
+        {
+            execute(data);
+        }
+        else
+        {
+            //the job we're waiting for is running on another thread
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_waitCondition.wait(lock, [&]() {return counter.complete() || m_queuedCount > 0; });
+        }
+    }
+
+    //make sure whichever thread completed the counter has released it
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+//private
+void JobSystem::push(JobData&& data)
+{
+    auto idx = (currentSystem == this) ? currentQueue : 0;
+    {
+        std::lock_guard<std::mutex> lock(m_queues[idx]->mutex);
+        m_queues[idx]->jobs.push_back(std::move(data));
+    }
+    m_queuedCount++;
+
+    //taking the lock prevents a worker missing the
+    //notification between testing and waiting
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCondition.notify_one();
+    m_waitCondition.notify_all();
+}
+
+bool JobSystem::pop(JobData& data)
+{
+    const auto idx = (currentSystem == this) ? currentQueue : 0;
+
+    //newest job from our own queue first as it's most likely to be cache-warm
+    {
+        auto& queue = *m_queues[idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            data = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            m_queuedCount--;
+            return true;
+        }
+    }
+
+    //else steal the oldest job from someone else
+    for (auto i = 1u; i < m_queues.size(); ++i)
+    {
+        auto& queue = *m_queues[(idx + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            data = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            m_queuedCount--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(JobData& data)
+{
+    data.job();
+
+    if (data.counter)
+    {
+        //the counter may be destroyed as soon as a waiting thread
+        //sees it complete, so it's only touched while locked
+        std::vector<JobCounter::Continuation> continuations;
+        bool completed = false;
+        {
+            std::lock_guard<std::mutex> lock(data.counter->m_mutex);
+            if (--data.counter->m_count == 0)
+            {
+                continuations.swap(data.counter->m_continuations);
+                completed = true;
+            }
+        }
+
+        for (auto& c : continuations)
+        {
+            push({ std::move(c.job), c.counter });
+        }
+
+        //wake any threads waiting on the counter
+        if (completed)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+            }
+            m_waitCondition.notify_all();
+        }
+    }
+}
+
+void JobSystem::threadFunc(std::size_t queueIndex)
+{
+    currentSystem = this;
+    currentQueue = queueIndex;
+
+    while (m_running)
+    {
+        JobData data;
+        if (pop(data))
+        {
+            execute(data);
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepCondition.wait(lock, [&]() {return !m_running || m_queuedCount > 0; });
+        }
+    }
+}
@@ -29,30 +29,58 @@ source distribution.
 
 #include <crogine/core/MessageBus.hpp>
 
+#include <algorithm>
+#include <thread>
+
 using namespace cro;
 
 namespace
 {
-    //max msg size is 128 bytes, so 128 messages
-    //maximum per frame is 16384 bytes
-    const std::size_t bufferSize = 16384u;
+    //max msg size is 128 bytes, so at least 128 messages
+    //per page. new pages are added if a frame needs more
+    const std::size_t PageSize = 16384u;
+}
+
+MessageBus::Page::Page(std::size_t pageSize)
+    : data  (std::make_unique<char[]>(pageSize)),
+    size    (pageSize),
+    offset  (0),
+    end     (pageSize)
+{
+
 }
 
 MessageBus::MessageBus()
-    : m_currentBuffer   (bufferSize),
-    m_pendingBuffer     (bufferSize),
-    m_inPointer         (m_pendingBuffer.data()),
-    m_outPointer        (m_currentBuffer.data()),
+    : m_pendingFrame    (&m_frames[0]),
+    m_activePosts       (0),
+    m_currentFrame      (&m_frames[1]),
     m_currentCount      (0),
-    m_pendingCount      (0),
+    m_outPage           (0),
+    m_outOffset         (0),
     m_enabled           (true)
-{}
+{
+    for (auto& frame : m_frames)
+    {
+        frame.pages.push_back(acquirePage());
+        frame.currentPage = frame.pages.back();
+        frame.messageCount = 0;
+    }
+}
 
 const Message& MessageBus::poll()
 {
-    static auto size = sizeof(Message);
-    const Message& m = *reinterpret_cast<Message*>(m_outPointer);
-    m_outPointer += (size + m.m_dataSize);
+    CRO_ASSERT(m_currentCount > 0, "No messages to poll");
+
+    //skip to the next page once this one is read
+    auto* page = m_currentFrame->pages[m_outPage];
+    while (m_outOffset >= std::min(page->offset.load(std::memory_order_relaxed), page->end.load(std::memory_order_relaxed)))
+    {
+        page = m_currentFrame->pages[++m_outPage];
+        m_outOffset = 0;
+    }
+
+    const Message& m = *reinterpret_cast<Message*>(page->data.get() + m_outOffset);
+    m_outOffset += HeaderSize + alignedSize(m.m_dataSize);
     m_currentCount--;
 
     return m;
@@ -62,11 +90,21 @@ bool MessageBus::empty()
 {
     if (m_currentCount == 0)
     {
-        m_currentBuffer.swap(m_pendingBuffer);
-        m_inPointer = m_pendingBuffer.data();
-        m_outPointer = m_currentBuffer.data();
-        m_currentCount = m_pendingCount;
-        m_pendingCount = 0;
+        //the frame just read becomes the new pending frame
+        resetFrame(*m_currentFrame);
+        auto* frame = m_pendingFrame.exchange(m_currentFrame);
+
+        //other threads may still be writing to the frame
+        //we just took, so wait for them to finish first
+        while (m_activePosts.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        m_currentFrame = frame;
+        m_currentCount = frame->messageCount.load(std::memory_order_relaxed);
+        m_outPage = 0;
+        m_outOffset = 0;
         return true;
     }
     return false;
@@ -74,5 +112,70 @@ bool MessageBus::empty()
 
 std::size_t MessageBus::pendingMessageCount() const
 {
-    return m_pendingCount;
-}
\ No newline at end of file
+    return m_pendingFrame.load()->messageCount.load(std::memory_order_relaxed);
+}
+
+//private
+char* MessageBus::beginPost(std::size_t size)
+{
+    //counting active posts before loading the frame means
+    //the frame can't be swapped for reading until we're done
+    m_activePosts.fetch_add(1);
+    auto* frame = m_pendingFrame.load();
+
+    while (true)
+    {
+        auto* page = frame->currentPage.load(std::memory_order_acquire);
+        auto start = page->offset.fetch_add(size, std::memory_order_relaxed);
+        if (start + size <= page->size)
+        {
+            frame->messageCount.fetch_add(1, std::memory_order_relaxed);
+            return page->data.get() + start;
+        }
+
+        //the page is full. messages are contiguous up to the first
+        //allocation which didn't fit, so mark that as the end of the page
+        auto end = page->end.load(std::memory_order_relaxed);
+        while (start < end
+            && !page->end.compare_exchange_weak(end, start, std::memory_order_relaxed)) {}
+
+        //only the first thread to get here adds a new page
+        std::lock_guard<std::mutex> lock(m_pageMutex);
+        if (frame->currentPage.load(std::memory_order_relaxed) == page)
+        {
+            auto* newPage = acquirePage();
+            frame->pages.push_back(newPage);
+            frame->currentPage.store(newPage, std::memory_order_release);
+        }
+    }
+}
+
+MessageBus::Page* MessageBus::acquirePage()
+{
+    if (m_freePages.empty())
+    {
+        m_pages.push_back(std::make_unique<Page>(PageSize));
+        return m_pages.back().get();
+    }
+
+    auto* page = m_freePages.back();
+    m_freePages.pop_back();
+    return page;
+}
+
+void MessageBus::resetFrame(Frame& frame)
+{
+    //keep the first page for the next frame and recycle the rest
+    std::lock_guard<std::mutex> lock(m_pageMutex);
+    for (auto* page : frame.pages)
+    {
+        page->offset = 0;
+        page->end = page->size;
+    }
+
+    m_freePages.insert(m_freePages.end(), frame.pages.begin() + 1, frame.pages.end());
+    frame.pages.resize(1);
+
+    frame.currentPage = frame.pages[0];
+    frame.messageCount = 0;
+}
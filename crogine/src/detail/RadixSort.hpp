@@ -0,0 +1,105 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/Types.hpp>
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace cro
+{
+    namespace Detail
+    {
+        //key and index of the item it refers to
+        using SortItem = std::pair<uint64, uint32>;
+
+        /*!
+        \brief Sorts the items in ascending order of key with an LSD radix sort,
+        one byte at a time. Bytes which are the same in every key, such as the
+        unused upper bits of small values, are skipped. The sort is stable.
+        \param items Items to sort
+        \param buffer Scratch space, resized as necessary. Keeping this between
+        calls saves reallocating it.
+        */
+        static inline void radixSort(std::vector<SortItem>& items, std::vector<SortItem>& buffer)
+        {
+            static constexpr std::size_t Passes = sizeof(uint64);
+            std::array<std::array<std::size_t, 256>, Passes> counts = {};
+
+            //count every digit in one pass over the data
+            for (const auto& item : items)
+            {
+                auto key = item.first;
+                for (auto i = 0u; i < Passes; ++i, key >>= 8)
+                {
+                    counts[i][key & 0xff]++;
+                }
+            }
+
+            buffer.resize(items.size());
+            auto* src = &items;
+            auto* dst = &buffer;
+            for (auto i = 0u; i < Passes; ++i)
+            {
+                auto& count = counts[i];
+                const auto shift = i * 8;
+
+                //all the keys share this byte
+                if (!items.empty()
+                    && count[((*src)[0].first >> shift) & 0xff] == items.size())
+                {
+                    continue;
+                }
+
+                //convert counts to output offsets
+                std::size_t offset = 0;
+                for (auto& c : count)
+                {
+                    auto n = c;
+                    c = offset;
+                    offset += n;
+                }
+
+                for (const auto& item : *src)
+                {
+                    (*dst)[count[(item.first >> shift) & 0xff]++] = item;
+                }
+                std::swap(src, dst);
+            }
+
+            if (src != &items)
+            {
+                items.swap(buffer);
+            }
+        }
+    }
+}
@@ -30,15 +30,20 @@ source distribution.
 #include <crogine/ecs/Component.hpp>
 #include <crogine/ecs/Entity.hpp>
 
+#include <mutex>
+
 using namespace cro;
 
 namespace
 {
     std::vector<std::type_index> IDs;
+    std::mutex mutex;
 }
 
 cro::Component::ID Component::getFromTypeID(std::type_index id)
 {
+    //only called once per type per module so locking here is cheap
+    std::lock_guard<std::mutex> lock(mutex);
     CRO_ASSERT(IDs.size() < Detail::MaxComponents, "Max components have been allocated");
 
     auto result = std::find(std::begin(IDs), std::end(IDs), id);
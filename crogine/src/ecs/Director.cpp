@@ -30,6 +30,8 @@ source distribution.
 #include <crogine/ecs/Director.hpp>
 #include <crogine/ecs/systems/CommandSystem.hpp>
 
+#include <algorithm>
+
 using namespace cro;
 
 Director::Director()
@@ -43,8 +45,29 @@ void Director::sendCommand(const Command& cmd)
     m_commandSystem->sendCommand(cmd);
 }
 
+void Director::sendCommand(Command&& cmd)
+{
+    CRO_ASSERT(m_commandSystem, "Missing command system!");
+    m_commandSystem->sendCommand(std::move(cmd));
+}
+
 Scene& Director::getScene()
 {
     CRO_ASSERT(m_scene, "Missing scene - are you using this correctly?");
     return *m_scene;
-}
\ No newline at end of file
+}
+
+void Director::subscribe(Message::ID id)
+{
+    if (std::find(m_subscriptions.begin(), m_subscriptions.end(), id) == m_subscriptions.end())
+    {
+        m_subscriptions.push_back(id);
+    }
+}
+
+//private
+bool Director::wantsMessage(Message::ID id) const
+{
+    return m_subscriptions.empty()
+        || std::find(m_subscriptions.begin(), m_subscriptions.end(), id) != m_subscriptions.end();
+}
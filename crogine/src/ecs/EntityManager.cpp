@@ -28,24 +28,40 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/ecs/Entity.hpp>
+#include <crogine/ecs/Prefab.hpp>
 #include <crogine/detail/Assert.hpp>
 #include <crogine/core/MessageBus.hpp>
 
 using namespace cro;
 
-EntityManager::EntityManager(MessageBus& mb)
+EntityManager::EntityManager(MessageBus& mb, std::size_t initialCapacity)
     : m_messageBus  (mb),
+    m_freeHead      (0),
     m_componentPools(Detail::MaxComponents)
-{}
+{
+    CRO_ASSERT(initialCapacity <= (std::size_t(1) << Detail::IndexBits), "Capacity out of range");
+
+    m_freeIDs.reserve(initialCapacity);
+    m_generations.reserve(initialCapacity);
+    m_componentMasks.reserve(initialCapacity);
+    m_changeFlags.reserve(initialCapacity);
+}
 
 //public
 Entity EntityManager::createEntity()
 {
     Entity::ID idx;
-    if (m_freeIDs.size() > Detail::MinFreeIDs)
+    if (m_freeIDs.size() - m_freeHead > Detail::MinFreeIDs)
     {
-        idx = m_freeIDs.front();
-        m_freeIDs.pop_front();
+        idx = m_freeIDs[m_freeHead++];
+
+        //discard the consumed IDs once they make up half the
+        //vector, so the memory in use is bounded by the free count
+        if (m_freeHead * 2 >= m_freeIDs.size())
+        {
+            m_freeIDs.erase(m_freeIDs.begin(), m_freeIDs.begin() + m_freeHead);
+            m_freeHead = 0;
+        }
     }
     else
     {
@@ -56,6 +72,7 @@ Entity EntityManager::createEntity()
         if (idx >= m_componentMasks.size())
         {
             m_componentMasks.resize(idx + 1);
+            m_changeFlags.resize(idx + 1, false);
         }
     }
 
@@ -71,8 +88,29 @@ void EntityManager::destroyEntity(Entity entity)
     const auto index = entity.getIndex();
     CRO_ASSERT(index < m_generations.size(), "Index out of range");
 
-    ++m_generations[index];
-    m_freeIDs.push_back(index);
+    if (entityDestroyed(entity))
+    {
+        return;
+    }
+
+    //once an index has been used for every generation it's retired
+    //rather than wrapping back to zero, so stale handles can never
+    //alias a new entity. MaxGeneration is never handed out, so all
+    //handles to a retired index report being destroyed
+    if (++m_generations[index] < Detail::MaxGeneration)
+    {
+        m_freeIDs.push_back(index);
+    }
+
+    //release the entity's components so pools only hold live data.
+    //this includes any removed components which are yet to be flushed
+    for (auto& pool : m_componentPools)
+    {
+        if (pool && pool->contains(index))
+        {
+            pool->remove(index);
+        }
+    }
     m_componentMasks[index].reset();
 
     //let the world know the entity was destroyed
@@ -106,7 +144,53 @@ const ComponentMask& EntityManager::getComponentMask(Entity entity) const
     return m_componentMasks[index];
 }
 
+void EntityManager::instantiate(const Prefab& prefab, const std::vector<Entity>& entities)
+{
+    prefab.copyComponents(*this, entities);
+
+    const auto& mask = prefab.getComponentMask();
+    for (auto entity : entities)
+    {
+        CRO_ASSERT(!entityDestroyed(entity), "Entity has been destroyed");
+        m_componentMasks[entity.getIndex()] |= mask;
+    }
+}
+
 bool EntityManager::owns(Entity entity) const
 {
     return (entity.m_entityManager == this);
-}
\ No newline at end of file
+}
+
+void EntityManager::flushComponentChanges()
+{
+    for (auto [entityID, componentID] : m_pendingRemovals)
+    {
+        //the component may have been added again since it was removed
+        auto& pool = m_componentPools[componentID];
+        if (!m_componentMasks[entityID].test(componentID)
+            && pool && pool->contains(entityID))
+        {
+            pool->remove(entityID);
+        }
+    }
+    m_pendingRemovals.clear();
+
+    for (auto entity : m_changedEntities)
+    {
+        m_changeFlags[entity.getIndex()] = false;
+    }
+    m_changedEntities.clear();
+}
+
+//private
+void EntityManager::markChanged(Entity entity)
+{
+    const auto index = entity.getIndex();
+    CRO_ASSERT(index < m_changeFlags.size(), "Entity index out of range");
+
+    if (!m_changeFlags[index])
+    {
+        m_changeFlags[index] = true;
+        m_changedEntities.push_back(entity);
+    }
+}
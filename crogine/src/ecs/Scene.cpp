@@ -32,6 +32,8 @@ source distribution.
 #include <crogine/ecs/components/Transform.hpp>
 #include <crogine/ecs/components/AudioListener.hpp>
 #include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/systems/SceneGraph.hpp>
+#include <crogine/ecs/systems/CameraSystem.hpp>
 
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/App.hpp>
@@ -60,10 +62,12 @@ namespace
     }
 }
 
-Scene::Scene(MessageBus& mb)
+Scene::Scene(MessageBus& mb, std::size_t initialCapacity)
     : m_messageBus      (mb),
-    m_entityManager     (mb),
+    m_entityManager     (mb, initialCapacity),
     m_systemManager     (*this),
+    m_deliveredCount    (0),
+    m_lastDeliveredCount(0),
     m_projectionMapCount(0)
 {
     auto defaultCamera = createEntity();
@@ -86,21 +90,26 @@ Scene::Scene(MessageBus& mb)
 //public
 void Scene::simulate(Time dt)
 {
+    m_lastDeliveredCount = m_deliveredCount;
+    m_deliveredCount = 0;
+
     //update directors first as they'll be working on data from the last frame
     for (auto& d : m_directors)
     {
         d->process(dt);
     }
 
-    for (const auto& entity : m_pendingEntities)
-    {
-        m_systemManager.addToSystems(entity);
-    }
+    m_systemManager.addToSystems(m_pendingEntities);
     m_pendingEntities.clear();
 
+    //entities which gained or lost components since the last
+    //frame move in to or out of the relevant systems
+    m_systemManager.updateSystems(m_entityManager.getChangedEntities());
+    m_entityManager.flushComponentChanges();
+
+    m_systemManager.removeFromSystems(m_destroyedEntities);
     for (const auto& entity : m_destroyedEntities)
     {
-        m_systemManager.removeFromSystems(entity);
         m_entityManager.destroyEntity(entity);
     }
     m_destroyedEntities.clear();
@@ -120,6 +129,21 @@ void Scene::destroyEntity(Entity entity)
     m_destroyedEntities.push_back(entity);
 }
 
+std::vector<Entity> Scene::instantiate(const Prefab& prefab, std::size_t count)
+{
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        entities.push_back(m_entityManager.createEntity());
+    }
+
+    m_entityManager.instantiate(prefab, entities);
+    m_pendingEntities.insert(m_pendingEntities.end(), entities.begin(), entities.end());
+
+    return entities;
+}
+
 Entity Scene::getEntity(Entity::ID id) const
 {
     return m_entityManager.getEntity(id);
@@ -212,10 +236,14 @@ void Scene::forwardMessage(const Message& msg)
         }
     }
 
-    m_systemManager.forwardMessage(msg);
+    m_deliveredCount += m_systemManager.forwardMessage(msg);
     for (auto& d : m_directors)
     {
-        d->handleMessage(msg);
+        if (d->wantsMessage(msg.id))
+        {
+            d->handleMessage(msg);
+            m_deliveredCount++;
+        }
     }
 
     if (msg.id == Message::WindowMessage)
@@ -245,7 +273,34 @@ void Scene::forwardMessage(const Message& msg)
 
 void Scene::render()
 {
-    currentRenderPath();
+    //blend transforms between the last two simulation steps
+    if (m_systemManager.hasSystem<SceneGraph>()
+        && m_systemManager.getSystem<SceneGraph>().getInterpolationEnabled())
+    {
+        auto& sceneGraph = m_systemManager.getSystem<SceneGraph>();
+        sceneGraph.beginInterpolation(App::getInterpolationAlpha());
+
+        //the camera view has to follow the blended transform too
+        //if it's being updated from the camera transform
+        auto& camera = m_entityManager.getEntity(m_activeCamera).getComponent<Camera>();
+        const auto viewMatrix = camera.viewMatrix;
+        const auto viewProjectionMatrix = camera.viewProjectionMatrix;
+        if (m_systemManager.hasSystem<CameraSystem>())
+        {
+            camera.viewMatrix = glm::inverse(m_entityManager.getEntity(m_activeCamera).getComponent<Transform>().getWorldTransform());
+            camera.viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
+        }
+
+        currentRenderPath();
+
+        camera.viewMatrix = viewMatrix;
+        camera.viewProjectionMatrix = viewProjectionMatrix;
+        sceneGraph.endInterpolation();
+    }
+    else
+    {
+        currentRenderPath();
+    }
 }
 
 std::pair<const float*, std::size_t> Scene::getActiveProjectionMaps() const
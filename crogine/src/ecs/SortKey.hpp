@@ -0,0 +1,77 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/Types.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*
+        Packs the state used to draw a mesh into a 64 bit key, so that sorting
+        the keys groups opaque geometry by shader, then material, then mesh,
+        drawing front to back within each group. Transparent geometry is always
+        drawn last and sorted back to front, as blending depends on draw order.
+
+        opaque:      | 0 | shader 12 | material 12 | mesh 15 | depth 24 |
+        transparent: | 1 | inverted depth 32 | shader 12 | material 12 | mesh 7 |
+
+        The mesh ID should identify the submesh being drawn, not just its
+        vertex buffer, so that draws which may be instanced end up adjacent.
+        IDs which don't fit are truncated, which only affects how well draws
+        are grouped, not correctness.
+        */
+        static inline uint64 makeSortKey(bool transparent, uint32 shader, uint32 material, uint32 mesh, float depth)
+        {
+            //positive floats sort in the same order as their bit patterns
+            depth = std::max(0.f, depth);
+            uint32 depthBits = 0;
+            std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+            const uint64 state = (static_cast<uint64>(shader & 0xfff) << 27)
+                | (static_cast<uint64>(material & 0xfff) << 15)
+                | (mesh & 0x7fff);
+
+            if (transparent)
+            {
+                return (1ull << 63)
+                    | (static_cast<uint64>(~depthBits) << 31)
+                    | (state >> 8);
+            }
+
+            //the sign bit is always 0, so use the 24 bits below it
+            return (state << 24) | ((depthBits >> 7) & 0xffffff);
+        }
+    }
+}
@@ -30,6 +30,8 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/core/Clock.hpp>
 
+#include <algorithm>
+
 using namespace cro;
 
 std::vector<Entity> System::getEntities() const
@@ -40,22 +42,50 @@ std::vector<Entity> System::getEntities() const
 //public
 void System::addEntity(Entity entity)
 {
+    const auto idx = entity.getIndex();
+    if (idx >= m_entityIndices.size())
+    {
+        m_entityIndices.resize(idx + 1, NullIndex);
+    }
+    else if (contains(idx))
+    {
+        return;
+    }
+
+    m_entityIndices[idx] = static_cast<std::uint32_t>(m_entities.size());
     m_entities.push_back(entity);
     onEntityAdded(entity);
 }
 
 void System::removeEntity(Entity entity)
 {
-    m_entities.erase(std::remove_if(std::begin(m_entities), std::end(m_entities),
-        [&entity, this](const Entity& e)
+    const auto idx = entity.getIndex();
+    if (!contains(idx))
     {
-        if (entity == e)
-        {
-            onEntityRemoved(e);
-            return true;
-        }
-        return false;
-    }), std::end(m_entities));
+        return;
+    }
+
+    //a stale handle may share its index with a live entity, which
+    //must be left alone, so the generation has to match too
+    const auto pos = m_entityIndices[idx];
+    if (m_entities[pos].getGeneration() != entity.getGeneration())
+    {
+        return;
+    }
+
+    onEntityRemoved(entity);
+
+    //swap with the last entity so removal doesn't have to shuffle
+    //the entire list. This means that the order of the list is not
+    //preserved, so systems which rely on it should re-sort when
+    //onEntityRemoved() is called.
+    if (pos != m_entities.size() - 1)
+    {
+        m_entities[pos] = m_entities.back();
+        m_entityIndices[m_entities[pos].getIndex()] = pos;
+    }
+    m_entities.pop_back();
+    m_entityIndices[idx] = NullIndex;
 }
 
 const ComponentMask& System::getComponentMask() const
@@ -68,6 +98,21 @@ void System::handleMessage(const Message&) {}
 void System::process(Time) {}
 
 //protected
+void System::subscribe(Message::ID id)
+{
+    if (std::find(m_subscriptions.begin(), m_subscriptions.end(), id) == m_subscriptions.end())
+    {
+        m_subscriptions.push_back(id);
+
+        //systems are usually constructed before they're added, but
+        //subscribing later must update any routes already built
+        if (m_systemManager)
+        {
+            m_systemManager->subscriptionAdded(*this, id);
+        }
+    }
+}
+
 void System::setScene(Scene& scene)
 {
     m_scene = &scene;
@@ -77,4 +122,29 @@ Scene* System::getScene()
 {
     CRO_ASSERT(m_scene, "Scene is nullptr - something went wrong!");
     return m_scene;
+}
+
+void System::entitiesReordered()
+{
+    std::fill(m_entityIndices.begin(), m_entityIndices.end(), NullIndex);
+    for (auto i = 0u; i < m_entities.size(); ++i)
+    {
+        m_entityIndices[m_entities[i].getIndex()] = static_cast<std::uint32_t>(i);
+    }
+}
+
+//private
+bool System::contains(Entity::ID idx)
+{
+    if (idx >= m_entityIndices.size()
+        || m_entityIndices[idx] == NullIndex)
+    {
+        return false;
+    }
+
+    //concrete systems may remove entities from the list directly
+    //(the AudioSystem does in onEntityAdded()) which leaves a stale
+    //entry behind, so make sure the position still refers to this entity
+    const auto pos = m_entityIndices[idx];
+    return pos < m_entities.size() && m_entities[pos].getIndex() == idx;
 }
\ No newline at end of file
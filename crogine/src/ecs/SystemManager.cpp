@@ -30,9 +30,19 @@ source distribution.
 #include <crogine/ecs/System.hpp>
 #include <crogine/core/Clock.hpp>
 
+#include "SystemScheduler.hpp"
+
+#include <algorithm>
+
 using namespace cro;
 
-SystemManager::SystemManager(Scene& scene) : m_scene(scene) {}
+SystemManager::SystemManager(Scene& scene)
+    : m_scene       (scene),
+    m_scheduler     (std::make_unique<Detail::SystemScheduler>()),
+    m_scheduleDirty (false)
+{}
+
+SystemManager::~SystemManager() = default;
 
 void SystemManager::addToSystems(Entity entity)
 {
@@ -55,18 +65,107 @@ void SystemManager::removeFromSystems(Entity entity)
     }
 }
 
-void SystemManager::forwardMessage(const Message& msg)
+void SystemManager::addToSystems(const std::vector<Entity>& entities)
+{
+    for (auto& sys : m_systems)
+    {
+        const auto& sysMask = sys->getComponentMask();
+        for (auto entity : entities)
+        {
+            if ((entity.getComponentMask() & sysMask) == sysMask)
+            {
+                sys->addEntity(entity);
+            }
+        }
+    }
+}
+
+void SystemManager::removeFromSystems(const std::vector<Entity>& entities)
 {
     for (auto& sys : m_systems)
+    {
+        for (auto entity : entities)
+        {
+            sys->removeEntity(entity);
+        }
+    }
+}
+
+void SystemManager::updateSystems(const std::vector<Entity>& entities)
+{
+    for (auto& sys : m_systems)
+    {
+        const auto& sysMask = sys->getComponentMask();
+        for (auto entity : entities)
+        {
+            const bool interested = ((entity.getComponentMask() & sysMask) == sysMask);
+            const bool member = sys->contains(entity.getIndex());
+
+            if (interested && !member)
+            {
+                sys->addEntity(entity);
+            }
+            else if (!interested && member)
+            {
+                sys->removeEntity(entity);
+            }
+        }
+    }
+}
+
+std::size_t SystemManager::forwardMessage(const Message& msg)
+{
+    CRO_ASSERT(msg.id >= 0, "Invalid message ID");
+    const auto id = static_cast<std::size_t>(msg.id);
+    if (id >= m_messageRoutes.size())
+    {
+        m_messageRoutes.resize(id + 1);
+    }
+
+    auto& route = m_messageRoutes[id];
+    if (!route.built)
+    {
+        for (auto& sys : m_systems)
+        {
+            const auto& subs = sys->m_subscriptions;
+            if (sys->m_handlesMessages
+                && (subs.empty() || std::find(subs.begin(), subs.end(), msg.id) != subs.end()))
+            {
+                route.systems.push_back(sys.get());
+            }
+        }
+        route.built = true;
+    }
+
+    for (auto* sys : route.systems)
     {
         sys->handleMessage(msg);
     }
+    return route.systems.size();
 }
 
 void SystemManager::process(Time dt)
 {
-    for (auto& system : m_systems)
+    if (m_scheduleDirty)
     {
-        system->process(dt);
+        m_scheduler->rebuild(m_systems);
+        m_scheduleDirty = false;
     }
-}
\ No newline at end of file
+    m_scheduler->process(dt);
+}
+
+void SystemManager::subscriptionAdded(const System& system, Message::ID id)
+{
+    if (system.m_subscriptions.size() == 1)
+    {
+        //the system previously received every message, so
+        //is no longer in any of the routes except this one
+        m_messageRoutes.clear();
+    }
+    else if (static_cast<std::size_t>(id) < m_messageRoutes.size())
+    {
+        auto& route = m_messageRoutes[id];
+        route.systems.clear();
+        route.built = false;
+    }
+}
@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "SystemScheduler.hpp"
+
+#include <crogine/core/App.hpp>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    bool conflicts(const System& a, const System& b)
+    {
+        if (!a.isParallel() || !b.isParallel())
+        {
+            return true;
+        }
+
+        return (a.getWriteMask() & b.getReadMask()).any()
+            || (b.getWriteMask() & a.getReadMask()).any();
+    }
+}
+
+void SystemScheduler::rebuild(const std::vector<std::unique_ptr<System>>& systems)
+{
+    m_nodes.clear();
+    m_nodes.resize(systems.size());
+    m_remainingDependencies.resize(systems.size());
+    m_hasParallel = false;
+
+    for (auto i = 0u; i < systems.size(); ++i)
+    {
+        m_nodes[i].system = systems[i].get();
+        m_hasParallel = m_hasParallel || systems[i]->isParallel();
+
+        //any earlier system which conflicts must complete first,
+        //so the order of conflicting systems is always the order
+        //in which they were added
+        for (auto j = 0u; j < i; ++j)
+        {
+            if (conflicts(*systems[j], *systems[i]))
+            {
+                m_nodes[j].dependents.push_back(i);
+                m_nodes[i].dependencyCount++;
+            }
+        }
+    }
+}
+
+void SystemScheduler::process(Time dt)
+{
+    if (!m_hasParallel)
+    {
+        for (auto& node : m_nodes)
+        {
+            node.system->process(dt);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frameTime = dt;
+    m_completedCount = 0;
+
+    for (auto i = 0u; i < m_nodes.size(); ++i)
+    {
+        m_remainingDependencies[i] = m_nodes[i].dependencyCount;
+        if (m_remainingDependencies[i] == 0)
+        {
+            setReady(i);
+        }
+    }
+
+    //the main thread runs serial systems as they become available,
+    //and executes pending jobs - including parallel systems - otherwise
+    auto& jobSystem = App::getJobSystem();
+    while (m_completedCount < m_nodes.size())
+    {
+        if (!m_readySerial.empty())
+        {
+            auto idx = m_readySerial.front();
+            m_readySerial.pop_front();
+
+            lock.unlock();
+            m_nodes[idx].system->process(dt);
+            lock.lock();
+
+            complete(idx);
+        }
+        else
+        {
+            //parallel systems readied by a running system are scheduled
+            //before its job completes, so the counter only reaches zero once
+            //there are no parallel systems left running, at which point either
+            //a serial system is ready or the frame is complete
+            lock.unlock();
+            jobSystem.wait(m_counter);
+            lock.lock();
+        }
+    }
+
+    //the last job to complete a node may not yet have released the counter
+    lock.unlock();
+    jobSystem.wait(m_counter);
+}
+
+//private
+void SystemScheduler::setReady(std::size_t idx)
+{
+    if (m_nodes[idx].system->isParallel())
+    {
+        App::getJobSystem().schedule([this, idx]()
+            {
+                m_nodes[idx].system->process(m_frameTime);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                complete(idx);
+            }, &m_counter);
+    }
+    else
+    {
+        m_readySerial.push_back(idx);
+    }
+}
+
+void SystemScheduler::complete(std::size_t idx)
+{
+    m_completedCount++;
+    for (auto d : m_nodes[idx].dependents)
+    {
+        if (--m_remainingDependencies[d] == 0)
+        {
+            setReady(d);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/ecs/System.hpp>
+#include <crogine/core/Clock.hpp>
+#include <crogine/core/JobSystem.hpp>
+
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Builds a dependency graph from the declared component access
+        of a set of systems, and processes them, running parallel systems
+        concurrently where their access does not conflict.
+        Used internally by the SystemManager.
+        */
+        class SystemScheduler final
+        {
+        public:
+            SystemScheduler() = default;
+
+            SystemScheduler(const SystemScheduler&) = delete;
+            SystemScheduler(SystemScheduler&&) = delete;
+            SystemScheduler& operator = (const SystemScheduler&) = delete;
+            SystemScheduler& operator = (SystemScheduler&&) = delete;
+
+            /*!
+            \brief Rebuilds the dependency graph. Must be called whenever
+            systems are added or removed.
+            */
+            void rebuild(const std::vector<std::unique_ptr<System>>&);
+
+            /*!
+            \brief Processes all the systems in the graph, returning once
+            they have all completed.
+            */
+            void process(Time);
+
+        private:
+            struct Node final
+            {
+                System* system = nullptr;
+                std::vector<std::size_t> dependents;
+                std::size_t dependencyCount = 0;
+            };
+            std::vector<Node> m_nodes;
+            bool m_hasParallel = false;
+
+            //per-frame state, guarded by the mutex
+            std::mutex m_mutex;
+            std::vector<std::size_t> m_remainingDependencies;
+            std::deque<std::size_t> m_readySerial;
+            std::size_t m_completedCount = 0;
+            Time m_frameTime;
+
+            //counts parallel systems scheduled with the job system
+            JobCounter m_counter;
+
+            void setReady(std::size_t);
+            void complete(std::size_t);
+        };
+    }
+}
@@ -0,0 +1,267 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include "TransformStore.hpp"
+
+#include <crogine/detail/glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define USE_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+#if defined(USE_SSE)
+    using Vec4 = __m128;
+    inline Vec4 set(float a, float b, float c, float d) { return _mm_set_ps(d, c, b, a); }
+    inline Vec4 loadUnaligned(const float* f) { return _mm_loadu_ps(f); }
+    inline Vec4 splat(float f) { return _mm_set1_ps(f); }
+    inline Vec4 add(Vec4 a, Vec4 b) { return _mm_add_ps(a, b); }
+    inline Vec4 sub(Vec4 a, Vec4 b) { return _mm_sub_ps(a, b); }
+    inline Vec4 mul(Vec4 a, Vec4 b) { return _mm_mul_ps(a, b); }
+    inline void storeUnaligned(float* f, Vec4 v) { _mm_storeu_ps(f, v); }
+    inline void transpose(Vec4& a, Vec4& b, Vec4& c, Vec4& d) { _MM_TRANSPOSE4_PS(a, b, c, d); }
+#elif defined(USE_NEON)
+    using Vec4 = float32x4_t;
+    inline Vec4 set(float a, float b, float c, float d)
+    {
+        const float f[] = { a, b, c, d };
+        return vld1q_f32(f);
+    }
+    inline Vec4 loadUnaligned(const float* f) { return vld1q_f32(f); }
+    inline Vec4 splat(float f) { return vdupq_n_f32(f); }
+    inline Vec4 add(Vec4 a, Vec4 b) { return vaddq_f32(a, b); }
+    inline Vec4 sub(Vec4 a, Vec4 b) { return vsubq_f32(a, b); }
+    inline Vec4 mul(Vec4 a, Vec4 b) { return vmulq_f32(a, b); }
+    inline void storeUnaligned(float* f, Vec4 v) { vst1q_f32(f, v); }
+    inline void transpose(Vec4& a, Vec4& b, Vec4& c, Vec4& d)
+    {
+        auto ab = vtrnq_f32(a, b);
+        auto cd = vtrnq_f32(c, d);
+        a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+        b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+        c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+        d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+    }
+#endif
+}
+
+TransformStore::TransformStore()
+    : m_count       (0),
+    m_paddingVec    (0.f),
+    m_paddingQuat   (1.f, 0.f, 0.f, 0.f),
+    m_paddingMatrix (1.f)
+{
+
+}
+
+//public
+void TransformStore::clear()
+{
+    m_count = 0;
+}
+
+void TransformStore::push(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, const glm::vec3& origin, glm::mat4& dst)
+{
+    //grow a whole batch at a time so the kernel never reads past the end
+    if (m_count == m_entries.size())
+    {
+        m_entries.resize(m_count + BatchSize);
+    }
+
+    auto& entry = m_entries[m_count++];
+    entry.position = &position;
+    entry.rotation = &rotation;
+    entry.scale = &scale;
+    entry.origin = &origin;
+    entry.dst = &dst;
+}
+
+void TransformStore::composeLocal()
+{
+#if defined(USE_SSE) || defined(USE_NEON)
+    //pad the last batch - any entries left over from a
+    //previous update may refer to transforms which are gone
+    for (auto i = m_count; i % BatchSize != 0; ++i)
+    {
+        m_entries[i] = { &m_paddingVec, &m_paddingQuat, &m_paddingVec, &m_paddingVec, &m_paddingMatrix };
+    }
+
+    const auto one = splat(1.f);
+    const auto two = splat(2.f);
+    const auto zero = splat(0.f);
+
+    for (auto i = 0u; i < m_count; i += BatchSize)
+    {
+        const auto& a = m_entries[i];
+        const auto& b = m_entries[i + 1];
+        const auto& c = m_entries[i + 2];
+        const auto& d = m_entries[i + 3];
+
+        auto x = set(a.rotation->x, b.rotation->x, c.rotation->x, d.rotation->x);
+        auto y = set(a.rotation->y, b.rotation->y, c.rotation->y, d.rotation->y);
+        auto z = set(a.rotation->z, b.rotation->z, c.rotation->z, d.rotation->z);
+        auto w = set(a.rotation->w, b.rotation->w, c.rotation->w, d.rotation->w);
+
+        auto x2 = mul(x, two);
+        auto y2 = mul(y, two);
+        auto z2 = mul(z, two);
+
+        auto xx = mul(x, x2);
+        auto yy = mul(y, y2);
+        auto zz = mul(z, z2);
+        auto xy = mul(x, y2);
+        auto xz = mul(x, z2);
+        auto yz = mul(y, z2);
+        auto wx = mul(w, x2);
+        auto wy = mul(w, y2);
+        auto wz = mul(w, z2);
+
+        //rotation columns multiplied by scale
+        auto sx = set(a.scale->x, b.scale->x, c.scale->x, d.scale->x);
+        auto sy = set(a.scale->y, b.scale->y, c.scale->y, d.scale->y);
+        auto sz = set(a.scale->z, b.scale->z, c.scale->z, d.scale->z);
+
+        auto c0x = mul(sub(sub(one, yy), zz), sx);
+        auto c0y = mul(add(xy, wz), sx);
+        auto c0z = mul(sub(xz, wy), sx);
+
+        auto c1x = mul(sub(xy, wz), sy);
+        auto c1y = mul(sub(sub(one, xx), zz), sy);
+        auto c1z = mul(add(yz, wx), sy);
+
+        auto c2x = mul(add(xz, wy), sz);
+        auto c2y = mul(sub(yz, wx), sz);
+        auto c2z = mul(sub(sub(one, xx), yy), sz);
+
+        //translation is position - (RS * origin)
+        auto ox = set(a.origin->x, b.origin->x, c.origin->x, d.origin->x);
+        auto oy = set(a.origin->y, b.origin->y, c.origin->y, d.origin->y);
+        auto oz = set(a.origin->z, b.origin->z, c.origin->z, d.origin->z);
+
+        auto px = set(a.position->x, b.position->x, c.position->x, d.position->x);
+        auto py = set(a.position->y, b.position->y, c.position->y, d.position->y);
+        auto pz = set(a.position->z, b.position->z, c.position->z, d.position->z);
+
+        auto c3x = sub(px, add(add(mul(c0x, ox), mul(c1x, oy)), mul(c2x, oz)));
+        auto c3y = sub(py, add(add(mul(c0y, ox), mul(c1y, oy)), mul(c2y, oz)));
+        auto c3z = sub(pz, add(add(mul(c0z, ox), mul(c1z, oy)), mul(c2z, oz)));
+        auto c3w = one;
+
+        //each column is currently spread across the batch, so transpose
+        //them into one column per transform
+        auto c0w = zero;
+        auto c1w = zero;
+        auto c2w = zero;
+        transpose(c0x, c0y, c0z, c0w);
+        transpose(c1x, c1y, c1z, c1w);
+        transpose(c2x, c2y, c2z, c2w);
+        transpose(c3x, c3y, c3z, c3w);
+
+        const Vec4 columns[BatchSize][4] =
+        {
+            { c0x, c1x, c2x, c3x },
+            { c0y, c1y, c2y, c3y },
+            { c0z, c1z, c2z, c3z },
+            { c0w, c1w, c2w, c3w }
+        };
+        for (auto j = 0u; j < BatchSize; ++j)
+        {
+            auto* dst = glm::value_ptr(*m_entries[i + j].dst);
+            for (auto k = 0u; k < 4u; ++k)
+            {
+                storeUnaligned(dst + (k * 4), columns[j][k]);
+            }
+        }
+    }
+#else
+    composeScalar(0, m_count);
+#endif
+}
+
+void TransformStore::multiply(const glm::mat4& lhs, const glm::mat4& rhs, glm::mat4& dst)
+{
+#if defined(USE_SSE) || defined(USE_NEON)
+    const auto* l = glm::value_ptr(lhs);
+    const auto* r = glm::value_ptr(rhs);
+    auto* d = glm::value_ptr(dst);
+
+    const auto l0 = loadUnaligned(l);
+    const auto l1 = loadUnaligned(l + 4);
+    const auto l2 = loadUnaligned(l + 8);
+    const auto l3 = loadUnaligned(l + 12);
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        const auto* c = r + (i * 4);
+        auto result = mul(l0, splat(c[0]));
+        result = add(result, mul(l1, splat(c[1])));
+        result = add(result, mul(l2, splat(c[2])));
+        result = add(result, mul(l3, splat(c[3])));
+        storeUnaligned(d + (i * 4), result);
+    }
+#else
+    dst = lhs * rhs;
+#endif
+}
+
+//private
+void TransformStore::composeScalar(std::size_t start, std::size_t end)
+{
+    for (auto i = start; i < end; ++i)
+    {
+        const auto& entry = m_entries[i];
+        const auto& rotation = *entry.rotation;
+        const auto& scale = *entry.scale;
+        const auto& origin = *entry.origin;
+
+        const float xx = 2.f * rotation.x * rotation.x;
+        const float yy = 2.f * rotation.y * rotation.y;
+        const float zz = 2.f * rotation.z * rotation.z;
+        const float xy = 2.f * rotation.x * rotation.y;
+        const float xz = 2.f * rotation.x * rotation.z;
+        const float yz = 2.f * rotation.y * rotation.z;
+        const float wx = 2.f * rotation.w * rotation.x;
+        const float wy = 2.f * rotation.w * rotation.y;
+        const float wz = 2.f * rotation.w * rotation.z;
+
+        auto& m = *entry.dst;
+        m[0] = glm::vec4(1.f - yy - zz, xy + wz, xz - wy, 0.f) * scale.x;
+        m[1] = glm::vec4(xy - wz, 1.f - xx - zz, yz + wx, 0.f) * scale.y;
+        m[2] = glm::vec4(xz + wy, yz - wx, 1.f - xx - yy, 0.f) * scale.z;
+        m[3] = glm::vec4(*entry.position, 1.f) - (m[0] * origin.x + m[1] * origin.y + m[2] * origin.z);
+    }
+}
@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+#include <crogine/detail/glm/vec3.hpp>
+#include <crogine/detail/glm/mat4x4.hpp>
+#include <crogine/detail/glm/gtc/quaternion.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace cro
+{
+    namespace Detail
+    {
+        /*!
+        \brief Batches transforms whose local matrices need recomposing so
+        that they can be composed four at a time with SSE or NEON where it
+        is available. Other platforms fall back to a scalar version of the
+        same kernel.
+        Each batch is loaded straight from the transforms' own position,
+        rotation, scale and origin in to SIMD registers, and the results
+        are written straight to their matrices, so the transform data is
+        never copied in to or out of intermediate arrays.
+        Used internally by the SceneGraph to batch update dirty transforms.
+        */
+        class TransformStore final
+        {
+        public:
+            static constexpr std::size_t BatchSize = 4;
+
+            TransformStore();
+
+            /*!
+            \brief Removes all transforms from the store, without
+            releasing any memory.
+            */
+            void clear();
+
+            /*!
+            \brief Adds a transform to the store. The references must
+            remain valid until composeLocal() has been called.
+            \param dst The composed local matrix is written here
+            */
+            void push(const glm::vec3& position, const glm::quat& rotation,
+                const glm::vec3& scale, const glm::vec3& origin, glm::mat4& dst);
+
+            /*!
+            \brief Returns the number of transforms in the store
+            */
+            std::size_t size() const { return m_count; }
+
+            /*!
+            \brief Composes translate * rotate * scale * translate(-origin)
+            for every transform in the store, writing each result to the
+            matrix given when the transform was pushed.
+            */
+            void composeLocal();
+
+            /*!
+            \brief Multiplies lhs by rhs and stores the result in dst.
+            dst may not alias either of the inputs.
+            */
+            static void multiply(const glm::mat4& lhs, const glm::mat4& rhs, glm::mat4& dst);
+
+        private:
+            struct Entry final
+            {
+                const glm::vec3* position = nullptr;
+                const glm::quat* rotation = nullptr;
+                const glm::vec3* scale = nullptr;
+                const glm::vec3* origin = nullptr;
+                glm::mat4* dst = nullptr;
+            };
+            std::vector<Entry> m_entries; //always a multiple of BatchSize in size
+            std::size_t m_count;
+
+            //partial batches are padded with an entry referring to these
+            glm::vec3 m_paddingVec;
+            glm::quat m_paddingQuat;
+            glm::mat4 m_paddingMatrix;
+
+            void composeScalar(std::size_t start, std::size_t end);
+        };
+    }
+}
@@ -28,14 +28,31 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/ComponentPool.hpp>
 
 #include <crogine/detail/glm/gtx/euler_angles.hpp>
 #include <crogine/detail/glm/gtx/quaternion.hpp>
 
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+
 using namespace cro;
 
+namespace
+{
+    glm::mat4 composeTransform(glm::vec3 position, glm::quat rotation, glm::vec3 scale, glm::vec3 origin)
+    {
+        glm::mat4 translation = glm::translate(glm::mat4(1.f), position);
+
+        auto retVal = glm::toMat4(rotation);
+        retVal = glm::scale(retVal, scale);
+        retVal = glm::translate(retVal, -origin);
+
+        return translation * retVal;
+    }
+}
+
 Transform::Transform()
     : m_origin      (0.f, 0.f, 0.f),
     m_position      (0.f, 0.f, 0.f),
@@ -43,12 +60,21 @@ Transform::Transform()
     m_rotation      (1.f, 0.f, 0.f, 0.f),
     m_transform     (1.f),
     m_worldTransform(1.f),
+    m_worldPosition (0.f, 0.f, 0.f),
+    m_worldRotation (1.f, 0.f, 0.f, 0.f),
+    m_worldScale    (1.f, 1.f, 1.f),
     m_parent        (-1),
-    m_lastParent    (-1),
     m_id            (-1),
+    m_parentEntity  (0, 0),
+    m_linkedParent  (-1),
+    m_firstChild    (-1),
+    m_nextSibling   (-1),
+    m_previousSibling(-1),
+    m_pool          (nullptr),
+    m_static        (false),
     m_dirtyFlags    (0)
 {
-    for(auto& c : m_children) c = -1;
+
 }
 
 //public
@@ -106,7 +132,38 @@ glm::vec3 Transform::getPosition() const
 
 glm::vec3 Transform::getWorldPosition() const
 {
-    return glm::vec3(getWorldTransform()[3]) + ((m_origin * m_scale) * m_rotation);
+    if (linkPending())
+    {
+        return glm::vec3(getPendingWorldTransform() * glm::vec4(m_origin, 1.f));
+    }
+
+    //the origin is the point which is moved to the position
+    return (m_parent > -1) ? m_worldPosition : m_position;
+}
+
+glm::quat Transform::getWorldRotation() const
+{
+    if (linkPending() && m_parentEntity.hasComponent<Transform>())
+    {
+        return m_parentEntity.getComponent<Transform>().getWorldRotation() * m_rotation;
+    }
+    return (m_parent > -1) ? m_worldRotation : m_rotation;
+}
+
+glm::vec3 Transform::getWorldScale() const
+{
+    if (linkPending())
+    {
+        auto tx = getPendingWorldTransform();
+        return glm::vec3(glm::length(glm::vec3(tx[0])), glm::length(glm::vec3(tx[1])), glm::length(glm::vec3(tx[2])));
+    }
+    return (m_parent > -1) ? m_worldScale : glm::abs(m_scale);
+}
+
+float Transform::getMaxWorldScale() const
+{
+    auto scale = getWorldScale();
+    return std::max(scale.x, std::max(scale.y, scale.z));
 }
 
 glm::vec3 Transform::getRotation() const
@@ -129,14 +186,7 @@ const glm::mat4& Transform::getLocalTransform() const
     if (m_dirtyFlags & Tx)
     {
         //m_dirtyFlags &= ~Tx;
-
-        glm::mat4 translation = glm::translate(glm::mat4(1.f), m_position);
-
-        auto rotation = glm::toMat4(m_rotation);
-        rotation = glm::scale(rotation, m_scale);
-        rotation = glm::translate(rotation, -m_origin);
-
-        m_transform = translation * rotation;
+        m_transform = composeTransform(m_position, m_rotation, m_scale, m_origin);
     }
 
     return m_transform;
@@ -144,7 +194,20 @@ const glm::mat4& Transform::getLocalTransform() const
 
 glm::mat4 Transform::getWorldTransform() const
 {
-    return (m_parent > -1) ? m_worldTransform : getLocalTransform();
+    if (linkPending())
+    {
+        return getPendingWorldTransform();
+    }
+
+    if (m_parent > -1)
+    {
+        return m_worldTransform;
+    }
+
+    //the SceneGraph rebuilds the cached matrix each update, so this only
+    //composes a new one if the transform was modified since - and doesn't
+    //write to it, so systems only reading transforms can run in parallel
+    return (m_dirtyFlags & Tx) ? composeTransform(m_position, m_rotation, m_scale, m_origin) : m_transform;
 }
 
 void Transform::setParent(Entity parent)
@@ -156,54 +219,55 @@ void Transform::setParent(Entity parent)
     int32 newID = parent.getIndex();
     if (m_parent == newID) return;
 
-    m_lastParent = m_parent;
     m_parent = newID;
+    m_parentEntity = parent;
 
     m_dirtyFlags |= Parent;
 }
 
 void Transform::removeParent()
 {
-    m_lastParent = m_parent;
     m_parent = -1;
     m_dirtyFlags |= Parent;
 }
 
-bool Transform::addChild(uint32 id)
+const std::vector<int32>& Transform::getChildIDs() const
 {
-    auto freeSlot = std::find_if(std::begin(m_children), std::end(m_children), [id](int32 i) {return (i == -1 || i == id); });
-    if (freeSlot != std::end(m_children))
+    //childless transforms share a list rather than each allocating their own
+    static const std::vector<int32> NoChildren(1, -1);
+    if (m_firstChild == -1)
     {
-        if (*freeSlot > -1)
+        return NoChildren;
+    }
+
+    if (m_dirtyFlags & Child)
+    {
+        CRO_ASSERT(m_pool, "Transform has children but no pool");
+
+        m_childIDs.clear();
+        for (auto c = m_firstChild; c != -1; c = m_pool->at(c).m_nextSibling)
         {
-            m_removedChildren.push_back(*freeSlot);
+            m_childIDs.push_back(c);
         }
-        
-        *freeSlot = id;
-        //we have to sort these descending so negative values are last
-        std::sort(std::begin(m_children), std::end(m_children), [](int32 i, int32 j) { return i > j; });
-
-        //mark for update
-        m_dirtyFlags |= Child;
-        return true;
+        //this is the order in which the list has always been returned
+        std::sort(m_childIDs.begin(), m_childIDs.end(), [](int32 a, int32 b) { return a > b; });
+        m_childIDs.push_back(-1);
+
+        m_dirtyFlags &= ~Child;
     }
-    return false;
+    return m_childIDs;
 }
 
-void Transform::removeChild(uint32 id)
+//private
+glm::mat4 Transform::getPendingWorldTransform() const
 {
-    auto freeSlot = std::find(std::begin(m_children), std::end(m_children), id);
-    if (freeSlot != std::end(m_children))
+    //the SceneGraph hasn't linked the new parent yet, so use the parent's
+    //world transform, which is itself calculated if its link is pending
+    auto local = (m_dirtyFlags & Tx) ? composeTransform(m_position, m_rotation, m_scale, m_origin) : m_transform;
+    if (!m_parentEntity.hasComponent<Transform>())
     {
-        //if (*freeSlot > -1)
-        {
-            m_removedChildren.push_back(*freeSlot);
-        }
-        *freeSlot = -1;
+        //the parent was removed, the SceneGraph will reject it
+        return local;
     }
-
-    std::sort(std::begin(m_children), std::end(m_children), [](int32 i, int32 j) { return i > j; });
-
-    //mark for update
-    m_dirtyFlags |= Child;
+    return m_parentEntity.getComponent<Transform>().getWorldTransform() * local;
 }
@@ -30,36 +30,48 @@ source distribution.
 #include <crogine/ecs/systems/CameraSystem.hpp>
 #include <crogine/ecs/components/Camera.hpp>
 #include <crogine/ecs/components/Transform.hpp>
+#include <crogine/core/App.hpp>
 
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
 
 
 using namespace cro;
 
+namespace
+{
+    constexpr std::size_t GrainSize = 4;
+}
+
 CameraSystem::CameraSystem(cro::MessageBus& mb)
     : System(mb, typeid(CameraSystem))
 {
     requireComponent<Camera>();
-    requireComponent<Transform>();
+    requireComponent<Transform>(Access::Read);
+
+    setParallel(true);
 }
 
 //public
 void CameraSystem::process(Time)
 {
     auto& entities = getEntities();
-    for (auto entity : entities)
+    App::getJobSystem().parallelFor(entities.size(), GrainSize,
+        [&](std::size_t begin, std::size_t end)
     {
-        //TODO could dirty flag optimise as updating the frustum
-        //requires 6(!!) sqrts
+        for (auto i = begin; i < end; ++i)
+        {
+            //TODO could dirty flag optimise as updating the frustum
+            //requires 6(!!) sqrts
 
-        auto& camera = entity.getComponent<Camera>();
-        const auto& tx = entity.getComponent<Transform>();
+            auto& camera = entities[i].getComponent<Camera>();
+            const auto& tx = entities[i].getComponent<Transform>();
 
-        camera.viewMatrix = glm::inverse(tx.getWorldTransform());
-        camera.viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
+            camera.viewMatrix = glm::inverse(tx.getWorldTransform());
+            camera.viewProjectionMatrix = camera.projectionMatrix * camera.viewMatrix;
 
-        updateFrustum(camera);
-    }
+            updateFrustum(camera);
+        }
+    });
 }
 
 //private
@@ -169,13 +169,18 @@ void CollisionSystem::process(cro::Time dt)
     for (auto& entity : entities)
     {
         const auto& tx = entity.getComponent<Transform>();
-        auto rot = tx.getRotationQuat();
+        auto rot = tx.getWorldRotation();
         auto pos = tx.getWorldPosition();
         btTransform btXf(btQuaternion(rot.x, rot.y, rot.z, rot.w), btVector3(pos.x, pos.y, pos.z));
-        m_collisionData[entity.getIndex()].object->setWorldTransform(btXf);
+        auto& object = m_collisionData[entity.getIndex()].object;
+        object->setWorldTransform(btXf);
 
         auto& data = entity.getComponent<PhysicsObject>();
         data.m_collisionCount = 0;
+
+        //components may be moved within their pool when other
+        //entities are destroyed, so refresh the pointer each frame
+        object->setUserPointer(static_cast<void*>(&data));
     }
 
     //perform collisions
@@ -347,6 +352,11 @@ void CollisionSystem::onEntityAdded(cro::Entity entity)
     //read component data and create collision object
     auto& po = entity.getComponent<PhysicsObject>();
     auto idx = entity.getIndex();
+    if (idx >= m_collisionData.size())
+    {
+        m_collisionData.resize(idx + 1);
+        m_compoundShapes.resize(idx + 1);
+    }
 
     m_collisionData[idx].object = std::make_unique<btPairCachingGhostObject>();
 
@@ -392,7 +402,7 @@ void CollisionSystem::onEntityAdded(cro::Entity entity)
 void CollisionSystem::onEntityRemoved(cro::Entity entity)
 {
     std::size_t idx = entity.getIndex();
-    if (m_collisionData[idx].object)
+    if (idx < m_collisionData.size() && m_collisionData[idx].object)
     {
         m_collisionWorld->removeCollisionObject(m_collisionData[idx].object.get());
         m_collisionData[idx].object.reset();
@@ -31,47 +31,181 @@ source distribution.
 #include <crogine/ecs/systems/CommandSystem.hpp>
 #include <crogine/core/Clock.hpp>
 
+#include <algorithm>
+
 using namespace cro;
 
 namespace
 {
-    const std::size_t MaxCommands = 128; //this can be made larger if necessary, is only used to prevent continual reallocation of heap memory
+    const std::size_t InitialCommandCount = 128; //the queue grows as necessary, this just saves reallocating for the first few frames
 }
 
 CommandSystem::CommandSystem(MessageBus& mb)
     : System        (mb, typeid(CommandSystem)),
-    m_commands      (MaxCommands),
-    m_currentCommand(m_commands.begin()),
-    m_count         (0)
+    m_dirtyBuckets  (0),
+    m_currentStamp  (0)
 {
     requireComponent<CommandTarget>();
+
+    m_commands.reserve(InitialCommandCount);
+    m_activeCommands.reserve(InitialCommandCount);
 }
 
 //public
 void CommandSystem::sendCommand(const Command& cmd)
 {
-    *m_currentCommand = cmd;
-    m_currentCommand++;
-    m_count++;
-    CRO_ASSERT(m_currentCommand != m_commands.end(), "Exceeded max commands!");
+    m_commands.push_back(cmd);
+}
+
+void CommandSystem::sendCommand(Command&& cmd)
+{
+    m_commands.push_back(std::move(cmd));
+}
+
+void CommandSystem::updateTarget(Entity entity)
+{
+    m_changedTargets.push_back(entity);
 }
 
 void CommandSystem::process(Time dt)
 {
-    auto& entities = getEntities();
-    m_currentCommand = m_commands.begin();
+    if (m_commands.empty())
+    {
+        return;
+    }
+
+    //commands sent by other commands are queued for the next frame
+    m_commands.swap(m_activeCommands);
 
-    for (auto i = 0u; i < m_count; ++i, ++m_currentCommand)
+    refreshTargets();
+
+    for (const auto& cmd : m_activeCommands)
     {
-        for (auto& e : entities)
+        auto flags = cmd.targetFlags;
+        if ((flags & (flags - 1)) == 0)
         {
-            if (e.getComponent<CommandTarget>().ID & m_currentCommand->targetFlags)
+            //zero or one flag set, so no entity can be visited twice
+            for (auto i = 0u; flags != 0; ++i, flags >>= 1)
             {
-                m_currentCommand->action(e, dt);
+                if (flags & 1)
+                {
+                    for (auto e : m_buckets[i])
+                    {
+                        cmd.action(e, dt);
+                    }
+                }
             }
         }
+        else
+        {
+            if (++m_currentStamp == 0)
+            {
+                std::fill(m_visitStamps.begin(), m_visitStamps.end(), 0);
+                m_currentStamp = 1;
+            }
+
+            for (auto i = 0u; flags != 0; ++i, flags >>= 1)
+            {
+                if (flags & 1)
+                {
+                    for (auto e : m_buckets[i])
+                    {
+                        auto& stamp = m_visitStamps[e.getIndex()];
+                        if (stamp != m_currentStamp)
+                        {
+                            stamp = m_currentStamp;
+                            cmd.action(e, dt);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    m_activeCommands.clear();
+}
+
+//private
+void CommandSystem::onEntityAdded(Entity entity)
+{
+    if (entity.getIndex() >= m_targets.size())
+    {
+        m_targets.resize(entity.getIndex() + 1);
+        m_visitStamps.resize(entity.getIndex() + 1, 0);
+    }
+
+    auto& target = m_targets[entity.getIndex()];
+    target.id = entity.getComponent<CommandTarget>().ID;
+    target.generation = entity.getGeneration();
+    target.active = true;
+    addToBuckets(entity, target.id);
+}
+
+void CommandSystem::onEntityRemoved(Entity entity)
+{
+    //the entity is taken out of its buckets before they're next used
+    auto& target = m_targets[entity.getIndex()];
+    m_dirtyBuckets |= target.id;
+    target.id = 0;
+    target.active = false;
+}
+
+void CommandSystem::refreshTargets()
+{
+    for (auto e : m_changedTargets)
+    {
+        if (e.getIndex() >= m_targets.size())
+        {
+            continue;
+        }
+
+        auto& target = m_targets[e.getIndex()];
+        if (target.active
+            && target.generation == e.getGeneration()
+            && e.hasComponent<CommandTarget>())
+        {
+            //new flags can be appended, but removed flags
+            //mean the entity has to be taken out of those buckets
+            auto id = e.getComponent<CommandTarget>().ID;
+            addToBuckets(e, id & ~target.id);
+            m_dirtyBuckets |= (target.id & ~id);
+            target.id = id;
+        }
     }
+    m_changedTargets.clear();
 
-    m_currentCommand = m_commands.begin();
-    m_count = 0;
-}
\ No newline at end of file
+    //only the buckets which lost an entity need to be visited
+    for (auto i = 0u; m_dirtyBuckets != 0; ++i, m_dirtyBuckets >>= 1)
+    {
+        if (m_dirtyBuckets & 1)
+        {
+            const auto flag = (1u << i);
+            auto& bucket = m_buckets[i];
+            bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                [this, flag](Entity e)
+                {
+                    return !isTarget(e, flag);
+                }), bucket.end());
+        }
+    }
+}
+
+void CommandSystem::addToBuckets(Entity entity, uint32 flags)
+{
+    for (auto i = 0u; flags != 0; ++i, flags >>= 1)
+    {
+        if (flags & 1)
+        {
+            m_buckets[i].push_back(entity);
+        }
+    }
+}
+
+bool CommandSystem::isTarget(Entity entity, uint32 flags) const
+{
+    //the generation is checked in case the index has been
+    //reused by a new entity since this one was removed
+    const auto& target = m_targets[entity.getIndex()];
+    return target.generation == entity.getGeneration()
+        && (target.id & flags) != 0;
+}
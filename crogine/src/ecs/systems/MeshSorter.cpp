@@ -39,6 +39,7 @@ source distribution.
 #include <crogine/core/App.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../SortKey.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -59,17 +60,17 @@ void MeshSorter::process(cro::Time)
 {
     auto& entities = getEntities();   
     auto frustum = getScene()->getActiveCamera().getComponent<Camera>().getFrustum();
+    const auto& viewMatrix = getScene()->getActiveCamera().getComponent<Camera>().viewMatrix;
 
-    //cull entities by viewable into draw lists by pass
-    m_visibleEntities.reserve(entities.size() * 2);
+    //cull entities by viewable into the draw list
+    m_sortItems.clear();
     for (auto& entity : entities)
     {
-        auto model = entity.getComponent<Model>();
+        const auto& model = entity.getComponent<Model>();
         auto sphere = model.m_meshData.boundingSphere;
-        auto tx = entity.getComponent<Transform>();
+        const auto& tx = entity.getComponent<Transform>();
         sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre.x, sphere.centre.y, sphere.centre.z, 1.f));
-        auto scale = tx.getScale();
-        sphere.radius *= (scale.x + scale.y + scale.z) / 3.f;
+        sphere.radius *= tx.getMaxWorldScale();
 
         //DPRINT("Found entity", std::to_string(entity.getIndex()));
 
@@ -82,49 +83,35 @@ void MeshSorter::process(cro::Time)
 
         if (visible)
         {
-            auto opaque = std::make_pair(entity, SortData());
-            auto transparent = std::make_pair(entity, SortData());
-            
-            auto worldPos = tx.getWorldPosition();
+            auto depth = -(viewMatrix * glm::vec4(tx.getWorldPosition(), 1.f)).z;
 
-            //foreach material
-            //add ent/index pair to alpha or opaque list
+            //one item per submesh, each with its own key
             for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
             {
-                if (model.m_materials[i].blendMode != Material::BlendMode::None)
-                {
-                    transparent.second.matIDs.push_back(i);
-                    transparent.second.flags = static_cast<int64>(worldPos.z * 1000000.f); //suitably large number to shift decimal point
-                    transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-                }
-                else
-                {
-                    opaque.second.matIDs.push_back(i);
-                    opaque.second.flags = static_cast<int64>(-worldPos.z * 1000000.f);
-                }
-            }
-
-            //if (!opaque.second.matIDs.empty())
-            {
-                m_visibleEntities.push_back(opaque);
-            }
+                const auto& material = model.m_materials[i];
+                const bool isTransparent = (material.blendMode != Material::BlendMode::None);
 
-            //if (!transparent.second.matIDs.empty())
-            {
-                m_visibleEntities.push_back(transparent);
+                m_sortItems.emplace_back(Detail::makeSortKey(isTransparent, material.shader,
+                    static_cast<uint32>(material.id), model.m_meshData.vbo, depth), DrawItem({ entity, i }));
             }
         }
     }
-    //DPRINT("Visible ents", std::to_string(m_visibleEntities.size()));
+    //DPRINT("Visible ents", std::to_string(m_sortItems.size()));
     //DPRINT("Total ents", std::to_string(entities.size()));
 
-    //sort lists by depth
+    //sort lists by state and depth
     //sort opaque materials front to back
-    std::sort(std::begin(m_visibleEntities), std::end(m_visibleEntities),
-        [](MaterialPair& a, MaterialPair& b)
+    std::sort(std::begin(m_sortItems), std::end(m_sortItems),
+        [](const std::pair<uint64, DrawItem>& a, const std::pair<uint64, DrawItem>& b)
     {
-        return a.second.flags < b.second.flags;
+        return a.first < b.first;
     });
 
-    m_renderer.setDrawableList(m_visibleEntities);
+    m_drawList.clear();
+    for (const auto& item : m_sortItems)
+    {
+        m_drawList.push_back(item.second);
+    }
+
+    m_renderer.setDrawableList(m_drawList);
 }
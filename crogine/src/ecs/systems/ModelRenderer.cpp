@@ -33,22 +33,90 @@ source distribution.
 #include <crogine/ecs/components/Transform.hpp>
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/systems/SceneGraph.hpp>
 #include <crogine/core/Clock.hpp>
+#include <crogine/core/App.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/RadixSort.hpp"
+#include "../SortKey.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <string>
+
 using namespace cro;
 
+namespace
+{
+    constexpr std::size_t GrainSize = 64;
+
+    //parses a GL_VERSION string such as "3.3.0 NVIDIA 390.77" or
+    //"OpenGL ES 3.0 Mesa 18.0.5". Vertex attrib divisors are core
+    //from desktop GL 3.3 and GLES 3.0
+    bool versionSupportsInstancing(const char* version)
+    {
+        if (!version)
+        {
+            return false;
+        }
+
+        const std::string esPrefix("OpenGL ES");
+        std::string str(version);
+        const bool es = (str.compare(0, esPrefix.size(), esPrefix) == 0);
+        if (es)
+        {
+            const auto pos = str.find_first_of("0123456789");
+            if (pos == std::string::npos)
+            {
+                return false;
+            }
+            str = str.substr(pos);
+        }
+
+        int major = 0;
+        int minor = 0;
+        if (std::sscanf(str.c_str(), "%d.%d", &major, &minor) != 2)
+        {
+            return false;
+        }
+
+        return es ? (major >= 3) : (major > 3 || (major == 3 && minor >= 3));
+    }
+}
+
 ModelRenderer::ModelRenderer(MessageBus& mb)
-    : System            (mb, typeid(ModelRenderer)),
-    m_currentTextureUnit(0)
+    : System                (mb, typeid(ModelRenderer)),
+    m_currentTextureUnit    (0),
+    m_instancingSupported   (false),
+    m_instanceBuffer        (0)
 {
     requireComponent<Transform>();
     requireComponent<Model>();
+
+    //the context version is checked directly rather than relying on the
+    //ES loader's version flags, as desktop contexts are loaded with it too.
+    //On ES2 the loader leaves the instancing functions null
+    m_instancingSupported = (glDrawElementsInstanced && glVertexAttribDivisor
+        && versionSupportsInstancing(reinterpret_cast<const char*>(glGetString(GL_VERSION))));
+    if (m_instancingSupported)
+    {
+        glCheck(glGenBuffers(1, &m_instanceBuffer));
+    }
+}
+
+ModelRenderer::~ModelRenderer()
+{
+    if (m_instanceBuffer)
+    {
+        glCheck(glDeleteBuffers(1, &m_instanceBuffer));
+    }
 }
 
 //public
@@ -57,72 +125,98 @@ void ModelRenderer::process(Time)
     auto& entities = getEntities();
     auto frustum = getScene()->getActiveCamera().getComponent<Camera>().getFrustum();
 
-    //cull entities by viewable into draw lists by pass
-    m_visibleEntities.clear();
-    m_visibleEntities.reserve(entities.size() * 2);
-    for (auto& entity : entities)
+    //static models keep their world bounds unless the scene graph moved them
+    if (getScene()->hasSystem<SceneGraph>())
     {
-        auto& model = entity.getComponent<Model>();
-
-        auto sphere = model.m_meshData.boundingSphere;
-        const auto& tx = entity.getComponent<Transform>();
-        sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre.x, sphere.centre.y, sphere.centre.z, 1.f));
-        auto scale = tx.getScale();
-        sphere.radius *= ((scale.x + scale.y + scale.z) / 3.f);
-
-        model.m_visible = true;
-        std::size_t i = 0;
-        while (model.m_visible && i < frustum.size())
+        for (auto entity : getScene()->getSystem<SceneGraph>().getChangedTransforms())
         {
-            model.m_visible = (Spatial::intersects(frustum[i++], sphere) != Planar::Back);
+            if (entity.hasComponent<Model>())
+            {
+                entity.getComponent<Model>().m_boundsCached = false;
+            }
         }
+    }
 
-        if (model.m_visible)
+    //frustum test each model in batches across the job system
+    App::getJobSystem().parallelFor(entities.size(), GrainSize,
+        [&](std::size_t begin, std::size_t end)
+    {
+        for (auto j = begin; j < end; ++j)
         {
-            auto opaque = std::make_pair(entity, SortData());
-            auto transparent = std::make_pair(entity, SortData());
-
-            auto worldPos = tx.getWorldPosition();
+            auto& model = entities[j].getComponent<Model>();
+            const auto& tx = entities[j].getComponent<Transform>();
 
-            //foreach material
-            //add ent/index pair to alpha or opaque list
-            for (i = 0u; i < model.m_meshData.submeshCount; ++i)
+            if (!model.m_boundsCached)
             {
-                if (model.m_materials[i].blendMode != Material::BlendMode::None)
-                {
-                    transparent.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                    transparent.second.flags = static_cast<int64>(worldPos.z * 1000000.f); //suitably large number to shift decimal point
-                    transparent.second.flags += 0x0FFF000000000000; //gaurentees embiggenment so that sorting places transparent last
-                }
-                else
-                {
-                    opaque.second.matIDs.push_back(static_cast<std::int32_t>(i));
-                    opaque.second.flags = static_cast<int64>(-worldPos.z * 1000000.f);
-                }
+                auto sphere = model.m_meshData.boundingSphere;
+                sphere.centre = glm::vec3(tx.getWorldTransform() * glm::vec4(sphere.centre.x, sphere.centre.y, sphere.centre.z, 1.f));
+                sphere.radius *= tx.getMaxWorldScale();
+
+                model.m_worldBounds = sphere;
+                model.m_boundsCached = tx.isStatic();
             }
+            const auto& sphere = model.m_worldBounds;
 
-            if (!opaque.second.matIDs.empty())
+            model.m_visible = true;
+            std::size_t i = 0;
+            while (model.m_visible && i < frustum.size())
             {
-                m_visibleEntities.push_back(opaque);
+                model.m_visible = (Spatial::intersects(frustum[i++], sphere) != Planar::Back);
             }
+        }
+    });
+
+    //then gather the visible submeshes into the draw list
+    const auto& viewMatrix = getScene()->getActiveCamera().getComponent<Camera>().viewMatrix;
+    m_drawList.clear();
+    m_drawOrder.clear();
+    for (auto& entity : entities)
+    {
+        const auto& model = entity.getComponent<Model>();
+        if (model.m_visible)
+        {
+            const auto& tx = entity.getComponent<Transform>();
+            auto depth = -(viewMatrix * glm::vec4(tx.getWorldPosition(), 1.f)).z;
 
-            if (!transparent.second.matIDs.empty())
+            for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
             {
-                m_visibleEntities.push_back(transparent);
+                const auto& material = model.m_materials[i];
+                const bool transparent = (material.blendMode != Material::BlendMode::None);
+
+                //submeshes may share a material, so the submesh is part of the mesh
+                //ID else they interleave between models and can't be instanced
+                const auto meshID = (model.m_meshData.vbo * static_cast<uint32>(Mesh::IndexData::MaxBuffers)) + i;
+
+                m_drawOrder.emplace_back(Detail::makeSortKey(transparent, material.shader,
+                    static_cast<uint32>(material.id), meshID, depth), static_cast<uint32>(m_drawList.size()));
+                m_drawList.push_back({ entity, i });
             }
         }
     }
-    //DPRINT("Visible ents", std::to_string(m_visibleEntities.size()));
+    //DPRINT("Visible ents", std::to_string(m_drawList.size()));
     //DPRINT("Total ents", std::to_string(entities.size()));
 
-    //sort lists by depth
-    //flag values make sure transparent materials are rendered last
-    //with opaque going front to back and transparent back to front
-    std::sort(std::begin(m_visibleEntities), std::end(m_visibleEntities),
-        [](MaterialPair& a, MaterialPair& b)
+    //sort by key so opaque draws are grouped by shader and
+    //material, and transparent draws come last, back to front
+    Detail::radixSort(m_drawOrder, m_sortBuffer);
+
+    //consecutive items which share a mesh and material are drawn as one batch
+    m_batches.clear();
+    for (auto i = 0u; i < m_drawOrder.size();)
     {
-        return a.second.flags < b.second.flags;
-    });
+        const auto& first = m_drawList[m_drawOrder[i].second];
+        auto count = 1u;
+        if (m_instancingSupported)
+        {
+            while (i + count < m_drawOrder.size()
+                && canInstance(first, m_drawList[m_drawOrder[i + count].second]))
+            {
+                count++;
+            }
+        }
+        m_batches.emplace_back(i, count);
+        i += count;
+    }
 }
 
 void ModelRenderer::render(Entity camera)
@@ -133,77 +227,273 @@ void ModelRenderer::render(Entity camera)
     const auto& camTx = camera.getComponent<Transform>();
     auto cameraPosition = camTx.getWorldPosition();
 
-    glCheck(glCullFace(GL_BACK));
+    //other renderers may have changed the state since the last pass
+    m_renderState.reset();
+    m_renderState.setCullFace(GL_BACK);
+    m_passShaders.clear();
+
+    //attrib pointers only need to be set when the vertex layout changes
+    uint32 currentVBO = 0;
+    const Material::Data* currentMaterial = nullptr;
+
+    //world matrices for every instanced batch are uploaded together
+    m_instanceData.clear();
+    for (const auto& [first, count] : m_batches)
+    {
+        if (count > 1)
+        {
+            for (auto i = first; i < first + count; ++i)
+            {
+                const auto& tx = m_drawList[m_drawOrder[i].second].entity.getComponent<Transform>();
+                auto& instance = m_instanceData.emplace_back();
+                instance.worldMatrix = tx.getWorldTransform();
+                instance.normalMatrix = glm::inverseTranspose(glm::mat3(instance.worldMatrix));
+            }
+        }
+    }
 
-    //DPRINT("Render count", std::to_string(m_visibleEntities.size()));
-    for (const auto& e : m_visibleEntities)
+    if (!m_instanceData.empty())
     {
-        //calc entity transform
-        const auto& tx = e.first.getComponent<Transform>();
-        glm::mat4 worldMat = tx.getWorldTransform();
-        glm::mat4 worldView = camComponent.viewMatrix * worldMat;
-
-        //foreach submesh / material:
-        const auto& model = e.first.getComponent<Model>();
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
-        
-        for(auto i : e.second.matIDs)
+        //orphan the previous contents rather than waiting for them to be drawn
+        m_renderState.bindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+        glCheck(glBufferData(GL_ARRAY_BUFFER, m_instanceData.size() * sizeof(InstanceData), m_instanceData.data(), GL_STREAM_DRAW));
+    }
+    std::size_t instanceOffset = 0;
+
+    //transforms only need recalculating when the entity changes
+    //as submeshes of the same model are usually sorted together
+    uint32 currentEntity = std::numeric_limits<uint32>::max();
+    glm::mat4 worldMat = glm::mat4(1.f);
+    glm::mat4 worldView = glm::mat4(1.f);
+    glm::mat3 normalMat = glm::mat3(1.f);
+    uint32 meshAttribMask = 0;
+
+    //DPRINT("Render count", std::to_string(m_drawList.size()));
+    for (const auto& [first, count] : m_batches)
+    {
+        //state is shared by all items in a batch, so is taken from the first
+        const auto& item = m_drawList[m_drawOrder[first].second];
+        const auto& model = item.entity.getComponent<Model>();
+        const auto i = item.submesh;
+        const auto& material = model.m_materials[i];
+
+        if (count == 1
+            && item.entity.getIndex() != currentEntity)
         {
-            //bind shader
-            glCheck(glUseProgram(model.m_materials[i].shader));
+            currentEntity = item.entity.getIndex();
 
-            //apply shader uniforms from material
-            glCheck(glUniformMatrix4fv(model.m_materials[i].uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
-            applyProperties(model.m_materials[i], model);
+            //calc entity transform
+            const auto& tx = item.entity.getComponent<Transform>();
+            worldMat = tx.getWorldTransform();
+            worldView = camComponent.viewMatrix * worldMat;
+            normalMat = glm::inverseTranspose(glm::mat3(worldMat));
+        }
+        m_renderState.bindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo);
 
-            //apply standard uniforms
-            glCheck(glUniform3f(model.m_materials[i].uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
-            glCheck(glUniformMatrix4fv(model.m_materials[i].uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camComponent.projectionMatrix)));
-            glCheck(glUniformMatrix4fv(model.m_materials[i].uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
-            glCheck(glUniformMatrix3fv(model.m_materials[i].uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(glm::inverseTranspose(glm::mat3(worldMat)))));
+        //bind shader
+        m_renderState.useProgram(material.shader);
 
-            applyBlendMode(model.m_materials[i].blendMode);
+        //uniform values are kept by the shader, so the camera
+        //and scene lighting only need setting once per pass
+        if (std::find(m_passShaders.begin(), m_passShaders.end(), material.shader) == m_passShaders.end())
+        {
+            m_passShaders.push_back(material.shader);
+            applyPassUniforms(material, camComponent, cameraPosition);
+        }
 
-            //bind attribs
-            const auto& attribs = model.m_materials[i].attribs;
-            for (auto j = 0u; j < model.m_materials[i].attribCount; ++j)
+        //apply shader uniforms from material
+        applyProperties(material, model);
+
+        //apply standard uniforms. Instanced draws read their
+        //transforms from the instance buffer instead
+        if (count == 1)
+        {
+            glCheck(glUniformMatrix4fv(material.uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
+            glCheck(glUniformMatrix4fv(material.uniforms[Material::World], 1, GL_FALSE, glm::value_ptr(worldMat)));
+            glCheck(glUniformMatrix3fv(material.uniforms[Material::Normal], 1, GL_FALSE, glm::value_ptr(normalMat)));
+        }
+
+        applyBlendMode(material.blendMode);
+
+        //bind attribs
+        if (currentVBO != model.m_meshData.vbo
+            || currentMaterial != &material)
+        {
+            currentVBO = model.m_meshData.vbo;
+            currentMaterial = &material;
+
+            meshAttribMask = 0;
+            const auto& attribs = material.attribs;
+            for (auto j = 0u; j < material.attribCount; ++j)
             {
-                glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
+                meshAttribMask |= (1u << attribs[j][Material::Data::Index]);
                 glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
                     GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
-                    reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));               
+                    reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
             }
+        }
 
-            //bind element/index buffer
-            const auto& indexData = model.m_meshData.indexData[i];
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo));
+        //bind element/index buffer
+        const auto& indexData = model.m_meshData.indexData[i];
+        m_renderState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo);
 
-            //draw elements
-            glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
+        if (count > 1)
+        {
+            const auto instanceMask = applyInstanceAttribs(material, instanceOffset);
+            instanceOffset += count;
 
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+            m_renderState.setVertexAttribs(meshAttribMask | instanceMask);
+            m_renderState.setAttribDivisors(instanceMask);
 
-            //unbind attribs
-            for (auto j = 0u; j < model.m_materials[i].attribCount; ++j)
+            glCheck(glDrawElementsInstanced(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount,
+                static_cast<GLenum>(indexData.format), 0, static_cast<GLsizei>(count)));
+        }
+        else
+        {
+            //instanced shaders read the transform from the current attribute
+            //values when the instance attributes are not enabled
+            applyInstanceValues(material, worldMat, normalMat);
+
+            m_renderState.setVertexAttribs(meshAttribMask);
+            if (m_instancingSupported)
             {
-                glCheck(glDisableVertexAttribArray(attribs[j][Material::Data::Index]));
+                m_renderState.setAttribDivisors(0);
             }
+
+            //draw elements
+            glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
         }
-        
-        glCheck(glUseProgram(0));
     }
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    m_renderState.setVertexAttribs(0);
+    if (m_instancingSupported)
+    {
+        m_renderState.setAttribDivisors(0);
+    }
+    m_renderState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_renderState.bindBuffer(GL_ARRAY_BUFFER, 0);
+    m_renderState.useProgram(0);
 
-    glCheck(glDisable(GL_BLEND));
-    glCheck(glDisable(GL_CULL_FACE));
-    glCheck(glDisable(GL_DEPTH_TEST));
-    glCheck(glDepthMask(GL_TRUE)); //restore this else clearing the depth buffer fails
+    m_renderState.setCapability(RenderState::Blend, false);
+    m_renderState.setCapability(RenderState::CullFace, false);
+    m_renderState.setCapability(RenderState::DepthTest, false);
+    m_renderState.setDepthMask(true); //restore this else clearing the depth buffer fails
 
     restorePreviousViewport();
 }
 
 //private
+bool ModelRenderer::canInstance(const DrawItem& a, const DrawItem& b) const
+{
+    const auto& modelA = a.entity.getComponent<Model>();
+    const auto& modelB = b.entity.getComponent<Model>();
+    const auto& matA = modelA.m_materials[a.submesh];
+    const auto& matB = modelB.m_materials[b.submesh];
+
+    if (matA.instanceAttribs[Mesh::InstanceWorldMatrix] == -1
+        || modelA.m_jointCount != 0 || modelB.m_jointCount != 0
+        || modelA.m_meshData.vbo != modelB.m_meshData.vbo
+        || a.submesh != b.submesh
+        || matA.shader != matB.shader
+        || matA.id != matB.id
+        || matA.blendMode != matB.blendMode)
+    {
+        return false;
+    }
+
+    //models may have modified their copy of the material
+    return matA.propertyHash == matB.propertyHash;
+}
+
+uint32 ModelRenderer::applyInstanceAttribs(const Material::Data& material, std::size_t offset)
+{
+    m_renderState.bindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+    //matrix attributes take one location per column
+    uint32 mask = 0;
+    const auto stride = static_cast<GLsizei>(sizeof(InstanceData));
+    const auto base = offset * sizeof(InstanceData);
+
+    const auto worldLocation = material.instanceAttribs[Mesh::InstanceWorldMatrix];
+    for (auto i = 0; i < 4; ++i)
+    {
+        mask |= (1u << (worldLocation + i));
+        glCheck(glVertexAttribPointer(worldLocation + i, 4, GL_FLOAT, GL_FALSE, stride,
+            reinterpret_cast<void*>(base + offsetof(InstanceData, worldMatrix) + (i * sizeof(glm::vec4)))));
+    }
+
+    const auto normalLocation = material.instanceAttribs[Mesh::InstanceNormalMatrix];
+    if (normalLocation != -1)
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            mask |= (1u << (normalLocation + i));
+            glCheck(glVertexAttribPointer(normalLocation + i, 3, GL_FLOAT, GL_FALSE, stride,
+                reinterpret_cast<void*>(base + offsetof(InstanceData, normalMatrix) + (i * sizeof(glm::vec3)))));
+        }
+    }
+    return mask;
+}
+
+void ModelRenderer::applyInstanceValues(const Material::Data& material, const glm::mat4& worldMat, const glm::mat3& normalMat)
+{
+    const auto worldLocation = material.instanceAttribs[Mesh::InstanceWorldMatrix];
+    if (worldLocation != -1)
+    {
+        for (auto i = 0; i < 4; ++i)
+        {
+            glCheck(glVertexAttrib4fv(worldLocation + i, glm::value_ptr(worldMat[i])));
+        }
+    }
+
+    const auto normalLocation = material.instanceAttribs[Mesh::InstanceNormalMatrix];
+    if (normalLocation != -1)
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            glCheck(glVertexAttrib3fv(normalLocation + i, glm::value_ptr(normalMat[i])));
+        }
+    }
+}
+
+void ModelRenderer::applyPassUniforms(const Material::Data& material, const Camera& camera, glm::vec3 cameraPosition)
+{
+    glCheck(glUniform3f(material.uniforms[Material::Camera], cameraPosition.x, cameraPosition.y, cameraPosition.z));
+    glCheck(glUniformMatrix4fv(material.uniforms[Material::View], 1, GL_FALSE, glm::value_ptr(camera.viewMatrix)));
+    glCheck(glUniformMatrix4fv(material.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(camera.projectionMatrix)));
+
+    //scene wide values which are the same for every material using this shader
+    for (auto i = 0u; i < material.optionalUniformCount; ++i)
+    {
+        switch (material.optionalUniforms[i])
+        {
+        default: break;
+        case Material::ProjectionMap:
+        {
+            const auto p = getScene()->getActiveProjectionMaps();
+            glCheck(glUniformMatrix4fv(material.uniforms[Material::ProjectionMap], static_cast<GLsizei>(p.second), GL_FALSE, p.first));
+            glCheck(glUniform1i(material.uniforms[Material::ProjectionMapCount], static_cast<GLint>(p.second)));
+        }
+            break;
+        case Material::ShadowMapProjection:
+            glCheck(glUniformMatrix4fv(material.uniforms[Material::ShadowMapProjection], 1, GL_FALSE, glm::value_ptr(getScene()->getSunlight().getViewProjectionMatrix())));
+            break;
+        case Material::SunlightColour:
+        {
+            auto colour = getScene()->getSunlight().getColour();
+            glCheck(glUniform4f(material.uniforms[Material::SunlightColour], colour.getRed(), colour.getGreen(), colour.getBlue(), colour.getAlpha()));
+        }
+            break;
+        case Material::SunlightDirection:
+        {
+            auto dir = getScene()->getSunlight().getDirection();
+            glCheck(glUniform3f(material.uniforms[Material::SunlightDirection], dir.x, dir.y, dir.z));
+        }
+            break;
+        }
+    }
+}
+
 void ModelRenderer::applyProperties(const Material::Data& material, const Model& model)
 {
     m_currentTextureUnit = 0;
@@ -213,9 +503,7 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
         {
         default: break;
         case Material::Property::Texture:
-            //TODO track the current tex ID bound to this unit and only bind if different
-            glCheck(glActiveTexture(GL_TEXTURE0 + m_currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
+            m_renderState.bindTexture(m_currentTextureUnit, prop.second.second.textureID);
             glCheck(glUniform1i(prop.second.first, m_currentTextureUnit++));
             break;
         case Material::Property::Number:
@@ -250,33 +538,10 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
         case Material::Skinning:
             glCheck(glUniformMatrix4fv(material.uniforms[Material::Skinning], static_cast<GLsizei>(model.m_jointCount), GL_FALSE, &model.m_skeleton[0][0].x));
             break;
-        case Material::ProjectionMap:
-        {
-            const auto p = getScene()->getActiveProjectionMaps();
-            glCheck(glUniformMatrix4fv(material.uniforms[Material::ProjectionMap], static_cast<GLsizei>(p.second), GL_FALSE, p.first));
-            glCheck(glUniform1i(material.uniforms[Material::ProjectionMapCount], static_cast<GLint>(p.second)));
-        }
-            break;
-        case Material::ShadowMapProjection:
-            glCheck(glUniformMatrix4fv(material.uniforms[Material::ShadowMapProjection], 1, GL_FALSE, glm::value_ptr(getScene()->getSunlight().getViewProjectionMatrix())));
-            break;
         case Material::ShadowMapSampler:
-            glCheck(glActiveTexture(GL_TEXTURE0 + m_currentTextureUnit));
-            glCheck(glBindTexture(GL_TEXTURE_2D, getScene()->getSunlight().getMapID()));
+            m_renderState.bindTexture(m_currentTextureUnit, getScene()->getSunlight().getMapID());
             glCheck(glUniform1i(material.uniforms[Material::ShadowMapSampler], m_currentTextureUnit++));
             break;
-        case Material::SunlightColour:
-        {
-            auto colour = getScene()->getSunlight().getColour();
-            glCheck(glUniform4f(material.uniforms[Material::SunlightColour], colour.getRed(), colour.getGreen(), colour.getBlue(), colour.getAlpha()));
-        }
-            break;
-        case Material::SunlightDirection:
-        {
-            auto dir = getScene()->getSunlight().getDirection();
-            glCheck(glUniform3f(material.uniforms[Material::SunlightDirection], dir.x, dir.y, dir.z));
-        }
-            break;
         }
     }
 }
@@ -287,34 +552,40 @@ void ModelRenderer::applyBlendMode(Material::BlendMode mode)
     {
     default: break;
     case Material::BlendMode::Additive:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glBlendFunc(GL_ONE, GL_ONE));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(false);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setBlendFunc(GL_ONE, GL_ONE);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Alpha:
-        glCheck(glDisable(GL_CULL_FACE));
-        //glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::CullFace, false);
+        //m_renderState.setCapability(RenderState::DepthTest, false);
+        m_renderState.setDepthMask(false);
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Multiply:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(false);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setBlendFunc(GL_DST_COLOR, GL_ZERO);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::None:
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glDisable(GL_BLEND));
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(true);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setCapability(RenderState::Blend, false);
         break;
     }
 }
+
+void ModelRenderer::onEntityAdded(Entity entity)
+{
+    //the model may have been copied, or its transform replaced
+    entity.getComponent<Model>().m_boundsCached = false;
+}
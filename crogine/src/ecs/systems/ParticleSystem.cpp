@@ -102,6 +102,7 @@ namespace
     const std::size_t MaxParticleSystems = 64; //max number of VBOs - must be divisible by min count
     const std::size_t MinParticleSystems = 4; //min amount before resizing - this many added on resize (so don't make too large!!)
     const std::size_t VertexSize = 10 * sizeof(float); //pos, colour, rotation/scale vert attribs
+    constexpr std::size_t GrainSize = 4; //emitters per job
 }
 
 ParticleSystem::ParticleSystem(MessageBus& mb)
@@ -178,6 +179,9 @@ void ParticleSystem::process(Time dt)
 
     auto& entities = getEntities();
     auto frustum = getScene()->getActiveCamera().getComponent<Camera>().getFrustum();
+
+    //spawning uses the shared random number generator
+    //so new particles are emitted before going wide
     for (auto& e : entities)
     {
         //check each emitter to see if it should spawn a new particle
@@ -190,7 +194,7 @@ void ParticleSystem::process(Time dt)
             if (emitter.m_nextFreeParticle < emitter.m_particles.size() - 1)
             {
                 auto& tx = e.getComponent<Transform>();
-                glm::quat rotation = glm::quat_cast(tx.getLocalTransform());
+                auto rotation = tx.getWorldRotation();
 
                 const auto& settings = emitter.emitterSettings;
                 CRO_ASSERT(settings.emitRate > 0, "Emit rate must be grater than 0");
@@ -214,54 +218,78 @@ void ParticleSystem::process(Time dt)
 
                 emitter.m_nextFreeParticle++;
             }
-        }      
+        }
+    }
 
-        //update each particle
-        const float dtSec = dt.asSeconds();
-        glm::vec3 minBounds(std::numeric_limits<float>::max());
-        glm::vec3 maxBounds(0.f);
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    //update the particles of each emitter in batches across the job system.
+    //this part mustn't touch GL, VBOs are updated afterwards on this thread
+    m_emitterVisibility.resize(entities.size());
+    const float dtSec = dt.asSeconds();
+    App::getJobSystem().parallelFor(entities.size(), GrainSize,
+        [&, dtSec](std::size_t begin, std::size_t end)
+    {
+        for (auto j = begin; j < end; ++j)
         {
-            auto& p = emitter.m_particles[i];
+            auto& emitter = entities[j].getComponent<ParticleEmitter>();
 
-            p.velocity += p.gravity * dtSec;
-            for (auto f : emitter.emitterSettings.forces) p.velocity += f * dtSec;
-            p.position += p.velocity * dtSec;            
+            //update each particle
+            glm::vec3 minBounds(std::numeric_limits<float>::max());
+            glm::vec3 maxBounds(0.f);
+            for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+            {
+                auto& p = emitter.m_particles[i];
+
+                p.velocity += p.gravity * dtSec;
+                for (auto f : emitter.emitterSettings.forces) p.velocity += f * dtSec;
+                p.position += p.velocity * dtSec;            
            
-            p.lifetime -= dtSec;
-            p.colour.setAlpha(std::max(p.lifetime / p.maxLifeTime, 0.f));
+                p.lifetime -= dtSec;
+                p.colour.setAlpha(std::max(p.lifetime / p.maxLifeTime, 0.f));
 
-            p.rotation += emitter.emitterSettings.rotationSpeed * dtSec;
-            p.scale += ((p.scale * emitter.emitterSettings.scaleModifier) * dtSec);
-            //LOG(std::to_string(emitter.emitterSettings.scaleModifier), Logger::Type::Info);
+                p.rotation += emitter.emitterSettings.rotationSpeed * dtSec;
+                p.scale += ((p.scale * emitter.emitterSettings.scaleModifier) * dtSec);
 
-            //update bounds for culling
-            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
-            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
-            if (p.position.z < minBounds.z) minBounds.z = p.position.z;
+                //update bounds for culling
+                if (p.position.x < minBounds.x) minBounds.x = p.position.x;
+                if (p.position.y < minBounds.y) minBounds.y = p.position.y;
+                if (p.position.z < minBounds.z) minBounds.z = p.position.z;
 
-            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
-            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
-            if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
-        }
-        auto dist = (maxBounds - minBounds) / 2.f;
-        emitter.m_bounds.centre = dist + minBounds;
-        emitter.m_bounds.radius = glm::length(dist);
+                if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
+                if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
+                if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
+            }
+            auto dist = (maxBounds - minBounds) / 2.f;
+            emitter.m_bounds.centre = dist + minBounds;
+            emitter.m_bounds.radius = glm::length(dist);
 
-        //go over again and remove dead particles with pop/swap
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
-        {
-            if (emitter.m_particles[i].lifetime < 0)
+            //go over again and remove dead particles with pop/swap
+            for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
             {
-                emitter.m_nextFreeParticle--;
-                std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);                
+                if (emitter.m_particles[i].lifetime < 0)
+                {
+                    emitter.m_nextFreeParticle--;
+                    std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);                
+                }
+            }
+
+            //TODO sort by depth? should be drawing back to front for transparency really.
+
+            //check if not empty and within frustum
+            bool visible = (emitter.m_nextFreeParticle > 0);
+            std::size_t i = 0;
+            while (visible && i < frustum.size())
+            {
+                visible = (Spatial::intersects(frustum[i++], emitter.m_bounds) != Planar::Back);
             }
+            m_emitterVisibility[j] = visible ? 1 : 0;
         }
-        //DPRINT("Next free Particle", std::to_string(emitter.m_nextFreeParticle));
+    });
 
-        //TODO sort by depth? should be drawing back to front for transparency really.
+    //flush the vertex data to the VBOs and build the draw list
+    for (auto j = 0u; j < entities.size(); ++j)
+    {
+        const auto& emitter = entities[j].getComponent<ParticleEmitter>();
 
-        //update VBO
         std::size_t idx = 0;
         for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
         {
@@ -286,21 +314,9 @@ void ParticleSystem::process(Time dt)
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
         glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, idx * sizeof(float), m_dataBuffer.data()));
 
-
-        //check if not empty and within frustum and add to draw list
-        auto inView = [&frustum, &emitter]()->bool
+        if (m_emitterVisibility[j])
         {
-            bool visible = true;
-            std::size_t i = 0;
-            while (visible && i < frustum.size())
-            {
-                visible = (Spatial::intersects(frustum[i++], emitter.m_bounds) != Planar::Back);
-            }
-            return visible;
-        };
-        if (emitter.m_nextFreeParticle > 0 && inView())
-        {
-            m_visibleSystems[m_visibleCount++] = e;
+            m_visibleSystems[m_visibleCount++] = entities[j];
         }
     }
 
@@ -309,10 +325,11 @@ void ParticleSystem::process(Time dt)
 
 void ParticleSystem::render(Entity camera)
 {
-    glCheck(glEnable(GL_CULL_FACE));
-    glCheck(glEnable(GL_BLEND));
-    glCheck(glEnable(GL_DEPTH_TEST));
-    glCheck(glDepthMask(GL_FALSE));
+    m_renderState.reset();
+    m_renderState.setCapability(RenderState::CullFace, true);
+    m_renderState.setCapability(RenderState::Blend, true);
+    m_renderState.setCapability(RenderState::DepthTest, true);
+    m_renderState.setDepthMask(false);
     ENABLE_POINT_SPRITES;
         
     //particles are already in world space so just need viewProj
@@ -321,30 +338,34 @@ void ParticleSystem::render(Entity camera)
     auto vp = applyViewport(cam.viewport);
 
     //bind shader
-    glCheck(glUseProgram(m_shader.getGLHandle()));
+    m_renderState.useProgram(m_shader.getGLHandle());
 
     //set shader uniforms (texture/projection)
     glCheck(glUniformMatrix4fv(m_projectionUniform, 1, GL_FALSE, glm::value_ptr(cam.projectionMatrix)));
     glCheck(glUniformMatrix4fv(m_viewProjUniform, 1, GL_FALSE, glm::value_ptr(cam.viewProjectionMatrix)));
     glCheck(glUniform1f(m_viewportUniform, static_cast<float>(vp.height)));
     glCheck(glUniform1i(m_textureUniform, 0));
-    glCheck(glActiveTexture(GL_TEXTURE0));
-    
+
+    uint32 attribMask = 0;
+    for (const auto& attrib : m_attribData)
+    {
+        attribMask |= (1u << attrib.index);
+    }
 
     for(auto i = 0u; i < m_visibleCount; ++i)
     {
         const auto& emitter = m_visibleSystems[i].getComponent<ParticleEmitter>();
         //bind emitter texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, emitter.emitterSettings.textureID));
+        m_renderState.bindTexture(0, emitter.emitterSettings.textureID);
         glCheck(glUniform1f(m_sizeUniform, emitter.emitterSettings.size));
         
         //bind emitter vbo
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
+        m_renderState.bindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo);
 
         //bind vertex attribs
+        m_renderState.setVertexAttribs(attribMask);
         for (auto j = 0u; j < m_attribData.size(); ++j)
         {
-            glCheck(glEnableVertexAttribArray(m_attribData[j].index));
             glCheck(glVertexAttribPointer(m_attribData[j].index, m_attribData[j].attribSize,
                 GL_FLOAT, GL_FALSE, VertexSize,
                 reinterpret_cast<void*>(static_cast<intptr_t>(m_attribData[j].offset))));
@@ -355,35 +376,30 @@ void ParticleSystem::render(Entity camera)
         {
         default: break;
         case EmitterSettings::Alpha:
-            glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+            m_renderState.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             break;
         case EmitterSettings::Multiply:
-            glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
+            m_renderState.setBlendFunc(GL_DST_COLOR, GL_ZERO);
             break;
         case EmitterSettings::Add:
-            glCheck(glBlendFunc(GL_ONE, GL_ONE));
+            m_renderState.setBlendFunc(GL_ONE, GL_ONE);
             break;
         }
 
         //draw
         glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
-
-        //unbind attribs
-        for (auto j = 0u; j < m_attribData.size(); ++j)
-        {
-            glCheck(glDisableVertexAttribArray(m_attribData[j].index));
-        }
     }
 
-    glCheck(glUseProgram(0));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-    glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+    m_renderState.setVertexAttribs(0);
+    m_renderState.useProgram(0);
+    m_renderState.bindBuffer(GL_ARRAY_BUFFER, 0);
+    m_renderState.bindTexture(0, 0);
 
     restorePreviousViewport();
-    glCheck(glDisable(GL_CULL_FACE));
-    glCheck(glDisable(GL_BLEND));
-    glCheck(glDisable(GL_DEPTH_TEST));
-    glCheck(glDepthMask(GL_TRUE));
+    m_renderState.setCapability(RenderState::CullFace, false);
+    m_renderState.setCapability(RenderState::Blend, false);
+    m_renderState.setCapability(RenderState::DepthTest, false);
+    m_renderState.setDepthMask(true);
     DISABLE_POINT_SPRITES;
 }
 
@@ -33,176 +33,485 @@ source distribution.
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/App.hpp>
 
-#include <functional>
+#include "../TransformStore.hpp"
 
 using namespace cro;
 
 SceneGraph::SceneGraph(MessageBus& mb)
-    : System(mb, typeid(SceneGraph))
+    : System        (mb, typeid(SceneGraph)),
+    m_orderDirty    (false),
+    m_currentStamp  (0),
+    m_localTransforms(std::make_unique<Detail::TransformStore>()),
+    m_interpolate   (false),
+    m_syncPrevious  (false)
 {
     requireComponent<Transform>();
 }
 
+SceneGraph::~SceneGraph() = default;
+
 //public
 void SceneGraph::process(Time dt)
 {
-    std::vector<int32> updateList;
+    //children of entities destroyed last frame are destroyed with them.
+    //children of a transform which was only removed stay orphaned
+    for (const auto& [parent, child] : m_orphans)
+    {
+        if (parent.destroyed() && !child.destroyed())
+        {
+            getScene()->destroyEntity(child);
+        }
+    }
+    m_orphans.clear();
 
-    auto& entities = getEntities();
-    for (auto& entity : entities)
+    //static transforms are never checked for changes, so only
+    //dynamic transforms and newly added ones need relinking
+    auto& transforms = getScene()->getComponentPool<Transform>();
+    for (auto idx : m_order)
     {
-        //get entity tx node
-        auto& tx = entity.getComponent<Transform>();
-        bool addToList = false;
+        if (transforms.contains(idx))
+        {
+            updateParent(transforms, idx);
+        }
+    }
+
+    for (auto idx : m_newEntities)
+    {
+        if (transforms.contains(idx))
+        {
+            updateParent(transforms, idx);
+        }
+    }
 
-        //if node has dirty parent flag update parent with new child
-        if (tx.m_dirtyFlags & Transform::Parent)
+    if (m_interpolate)
+    {
+        //anything which moved last step is now at rest unless it
+        //changes again, so the previous transform catches up
+        for (auto e : m_changedTransforms)
         {
-            if (tx.m_parent > -1) //parent was added
+            m_previousTransforms[e.getIndex()] = m_currentTransforms[e.getIndex()];
+        }
+    }
+
+    m_currentStamp++;
+    m_changedTransforms.clear();
+
+    if (m_orderDirty)
+    {
+        //static transforms only need updating when the hierarchy changes.
+        //they can never be children of dynamic transforms so are updated first
+        rebuildOrder(transforms);
+        updateTransforms(transforms, m_staticOrder);
+        m_orderDirty = false;
+    }
+
+    updateTransforms(transforms, m_order);
+
+    if (m_interpolate)
+    {
+        //the values the Transform has now are those at the end of this
+        //step. new entities have nothing to blend from
+        if (m_syncPrevious)
+        {
+            for (auto e : getEntities())
             {
-                if (!getScene()->getEntity(tx.m_parent).getComponent<Transform>().addChild(entity.getIndex()))
-                {
-                    tx.m_parent = -1;
-                    LOG("Failed adding tx to parent - too many children already", Logger::Type::Error);
-                }
+                m_currentTransforms[e.getIndex()] = getLocal(transforms.at(e.getIndex()));
+                m_previousTransforms[e.getIndex()] = m_currentTransforms[e.getIndex()];
             }
-            if (tx.m_lastParent > -1) //remove old parent
+            m_syncPrevious = false;
+        }
+        else
+        {
+            for (auto e : m_changedTransforms)
             {
-                //remove the parent from all the children
-                auto& children = getScene()->getEntity(tx.m_lastParent).getComponent<Transform>().m_children;
-                //for (auto& c : children)
-                for(auto i =0u; children[i] != -1; ++i)
+                m_currentTransforms[e.getIndex()] = getLocal(transforms.at(e.getIndex()));
+            }
+
+            for (auto idx : m_newEntities)
+            {
+                if (transforms.contains(idx))
                 {
-                    getScene()->getEntity(children[i]).getComponent<Transform>().removeParent();
+                    m_currentTransforms[idx] = getLocal(transforms.at(idx));
+                    m_previousTransforms[idx] = m_currentTransforms[idx];
                 }
-
-                tx.m_lastParent = -1;
             }
-            addToList = true;
-            tx.m_dirtyFlags &= ~Transform::Parent;
         }
+    }
+    m_newEntities.clear();
+}
+
+const std::vector<Entity>& SceneGraph::getChangedTransforms() const
+{
+    return m_changedTransforms;
+}
+
+void SceneGraph::setInterpolationEnabled(bool enabled)
+{
+    if (enabled && !m_interpolate)
+    {
+        m_previousTransforms.resize(m_updateStamps.size());
+        m_currentTransforms.resize(m_updateStamps.size());
+        m_syncPrevious = true;
+    }
+    m_interpolate = enabled;
+}
+
+//private
+void SceneGraph::onEntityAdded(Entity entity)
+{
+    //nab our entity's index
+    auto& tx = entity.getComponent<Transform>();
+    tx.m_id = entity.getIndex();
+
+    //the transform may be a copy of one which was already linked
+    //so reset the hierarchy, and link it again if it has a parent
+    tx.m_linkedParent = -1;
+    tx.m_firstChild = -1;
+    tx.m_nextSibling = -1;
+    tx.m_previousSibling = -1;
+    tx.m_pool = &getScene()->getComponentPool<Transform>();
+    if (tx.m_parent > -1)
+    {
+        tx.m_dirtyFlags |= Transform::Parent;
+    }
+
+    if (entity.getIndex() >= m_updateStamps.size())
+    {
+        resizeStamps(entity.getIndex() + 1);
+    }
+    m_newEntities.push_back(entity.getIndex());
+    m_orderDirty = true;
+}
+
+void SceneGraph::onEntityRemoved(Entity entity)
+{
+    auto& transforms = getScene()->getComponentPool<Transform>();
+    const auto idx = entity.getIndex();
+
+    if (transforms.contains(idx))
+    {
+        unlink(transforms, idx);
+
+        //orphan the children now so that nothing refers to the dead
+        //transform, they are destroyed next frame if the entity was
+        auto& tx = transforms.at(idx);
+        auto c = tx.m_firstChild;
+        while (c != -1)
+        {
+            auto& child = transforms.at(c);
+            auto next = child.m_nextSibling;
+
+            child.m_parent = -1;
+            child.m_linkedParent = -1;
+            child.m_nextSibling = -1;
+            child.m_previousSibling = -1;
+            child.m_dirtyFlags |= Transform::Tx;
+            m_orphans.emplace_back(entity, getScene()->getEntity(c));
+
+            c = next;
+        }
+        tx.m_firstChild = -1;
+    }
+    m_orderDirty = true;
+}
 
-        //if node has dirty child find child and update its parent
-        if (tx.m_dirtyFlags & Transform::Child)
+void SceneGraph::updateParent(Detail::ComponentPool<Transform>& transforms, uint32 idx)
+{
+    //relink the node if it changed parent
+    auto& tx = transforms.at(idx);
+    if (tx.m_dirtyFlags & Transform::Parent)
+    {
+        if (tx.m_parent != tx.m_linkedParent)
         {
-            auto& children = tx.m_children;
-            for (auto c : children)
+            if (tx.m_parent > -1 && !canParent(transforms, idx, tx.m_parent))
             {
-                if (c == -1)
-                {
-                    break;
-                }
-                getScene()->getEntity(c).getComponent<Transform>().setParent(entity);
+                tx.m_parent = tx.m_linkedParent;
+                LOG("Failed adding tx to parent - parent is either missing or a child of this transform", Logger::Type::Error);
             }
-
-            auto& removedChildren = tx.m_removedChildren;
-            for (auto c : removedChildren)
+            else
             {
-                getScene()->getEntity(c).getComponent<Transform>().removeParent();
+                unlink(transforms, idx);
+                link(transforms, idx);
             }
-            removedChildren.clear();
-            addToList = true;
-            tx.m_dirtyFlags &= ~Transform::Child;
         }
 
-        //check transform for dirty flag        
-        if ((tx.m_dirtyFlags & Transform::Tx) || addToList)
+        tx.m_dirtyFlags &= ~Transform::Parent;
+        tx.m_dirtyFlags |= Transform::Tx;
+    }
+}
+
+void SceneGraph::updateTransforms(Detail::ComponentPool<Transform>& transforms, const std::vector<uint32>& order)
+{
+    //parents are always before their children in the list, so world
+    //transforms are updated in a single pass, visiting each node once.
+    //a node is updated if it's dirty or if its parent was updated
+    m_dirtyNodes.clear();
+    m_localTransforms->clear();
+    for (auto idx : order)
+    {
+        auto& tx = transforms.at(idx);
+        const bool parentUpdated = (tx.m_linkedParent > -1 && m_updateStamps[tx.m_linkedParent] == m_currentStamp);
+
+        if (tx.m_dirtyFlags & Transform::Tx)
         {
-            //walk to bottom and add to list
-            std::function<void (Transform&)> getLastNode = 
-                [&](Transform& xform)
-            {
-                xform.m_dirtyFlags |= Transform::Tx;
-                if (xform.m_children[0] == -1)
-                {
-                    updateList.push_back(xform.m_id);
-                    return;
-                }
-                for (auto c : xform.m_children)
-                {
-                    if (c == -1)
-                    {
-                        break;
-                    }
-                    getLastNode(getScene()->getEntity(c).getComponent<Transform>());
-                }
-            };
-            getLastNode(tx);
+            //local transform changed so it needs to be recomposed
+            m_localTransforms->push(tx.m_position, tx.m_rotation, tx.m_scale, tx.m_origin, tx.m_transform);
+            tx.m_dirtyFlags &= ~Transform::Tx;
+
+            m_dirtyNodes.push_back(idx);
+            m_updateStamps[idx] = m_currentStamp;
+        }
+        else if (parentUpdated)
+        {
+            m_dirtyNodes.push_back(idx);
+            m_updateStamps[idx] = m_currentStamp;
+        }
+    }
+
+    //compose all the changed local transforms as a batch
+    m_localTransforms->composeLocal();
+
+    //then propagate them, the dirty list is still sorted by depth
+    for (auto idx : m_dirtyNodes)
+    {
+        auto& tx = transforms.at(idx);
+        if (tx.m_linkedParent > -1)
+        {
+            const auto& parent = transforms.at(tx.m_linkedParent);
+            Detail::TransformStore::multiply(parent.m_worldTransform, tx.m_transform, tx.m_worldTransform);
+
+            updateWorldValues(tx, parent);
+        }
+        else
+        {
+            tx.m_worldTransform = tx.m_transform;
+        }
+
+        m_changedTransforms.push_back(getScene()->getEntity(idx));
+    }
+}
+
+bool SceneGraph::canParent(Detail::ComponentPool<Transform>& transforms, uint32 idx, int32 parent) const
+{
+    //walk up from the new parent to make sure this isn't one of its ancestors
+    while (parent != -1)
+    {
+        if (!transforms.contains(parent)
+            || static_cast<uint32>(parent) == idx)
+        {
+            return false;
         }
+        parent = transforms.at(parent).m_linkedParent;
     }
+    return true;
+}
 
-    //for each ID in the list recursively update transform (TODO could find a way to only go as far as last dirty)
-    //make sure to remove all dirty flags as we go
-    std::sort(updateList.begin(), updateList.end());
-    auto end = std::unique(updateList.begin(), updateList.end());
-    for (auto i = updateList.begin(); i != end; ++i)
+void SceneGraph::link(Detail::ComponentPool<Transform>& transforms, uint32 idx)
+{
+    auto& tx = transforms.at(idx);
+    if (tx.m_parent > -1)
     {
-        std::function<glm::mat4 (Transform&)> getWorldTransform = 
-            [&, this](Transform& xform)->glm::mat4
+        //children are pushed to the front of the list
+        auto& parent = transforms.at(tx.m_parent);
+        tx.m_nextSibling = parent.m_firstChild;
+        tx.m_previousSibling = -1;
+        if (parent.m_firstChild != -1)
         {
-            if (xform.m_parent > -1)
-            {
-                auto& parentTx = getScene()->getEntity(xform.m_parent).getComponent<Transform>();
-                parentTx.m_worldTransform = getWorldTransform(parentTx);
+            transforms.at(parent.m_firstChild).m_previousSibling = idx;
+        }
+        parent.m_firstChild = idx;
+        tx.m_linkedParent = tx.m_parent;
 
-                auto wtx = parentTx.m_worldTransform * xform.getLocalTransform();
-                xform.m_dirtyFlags &= ~Transform::Tx;
-                return wtx;
-            }
-            auto ltx = xform.getLocalTransform();
-            xform.m_dirtyFlags &= ~Transform::Tx;
-            return ltx;
-        };
-        auto& tx = getScene()->getEntity(*i).getComponent<Transform>();
-        tx.m_worldTransform = getWorldTransform(tx);
+        parent.m_dirtyFlags |= Transform::Child;
     }
-    /*int32 dbid = updateList.empty() ? 0 : updateList[0];
-    DPRINT("update Entity", std::to_string(std::distance(updateList.begin(), end)));*/
+    m_orderDirty = true;
 }
 
-void SceneGraph::handleMessage(const Message& msg)
+void SceneGraph::unlink(Detail::ComponentPool<Transform>& transforms, uint32 idx)
 {
-    std::function<void(std::array<int32, Transform::MaxChildren>&)> destroyChildren = 
-        [&, this](std::array<int32, Transform::MaxChildren>& children)
+    auto& tx = transforms.at(idx);
+    if (tx.m_linkedParent > -1)
     {
-        for (auto& c : children)
+        if (tx.m_previousSibling != -1)
         {
-            if (c > -1)
-            {
-                auto entity = getScene()->getEntity(c);
-                destroyChildren(entity.getComponent<Transform>().m_children);
-                //entity.destroy();
+            transforms.at(tx.m_previousSibling).m_nextSibling = tx.m_nextSibling;
+        }
+        else
+        {
+            transforms.at(tx.m_linkedParent).m_firstChild = tx.m_nextSibling;
+        }
 
-                getScene()->destroyEntity(entity);
+        if (tx.m_nextSibling != -1)
+        {
+            transforms.at(tx.m_nextSibling).m_previousSibling = tx.m_previousSibling;
+        }
 
-                c = -1; //mark the child as gone else the message from destroying this
-                //entity will become infinitely recursive...
-            }
-            else
+        transforms.at(tx.m_linkedParent).m_dirtyFlags |= Transform::Child;
+
+        tx.m_linkedParent = -1;
+        tx.m_nextSibling = -1;
+        tx.m_previousSibling = -1;
+    }
+    m_orderDirty = true;
+}
+
+void SceneGraph::rebuildOrder(Detail::ComponentPool<Transform>& transforms)
+{
+    //breadth first from each root so that nodes are sorted by depth
+    m_order.clear();
+    m_staticOrder.clear();
+    m_sortBuffer.clear();
+    for (auto& entity : getEntities())
+    {
+        if (transforms.at(entity.getIndex()).m_linkedParent == -1)
+        {
+            m_sortBuffer.push_back(entity.getIndex());
+        }
+    }
+
+    for (auto i = 0u; i < m_sortBuffer.size(); ++i)
+    {
+        for (auto c = transforms.at(m_sortBuffer[i]).m_firstChild; c != -1; c = transforms.at(c).m_nextSibling)
+        {
+            if (static_cast<std::size_t>(c) >= m_updateStamps.size())
             {
-                break;
+                resizeStamps(c + 1);
             }
+            m_sortBuffer.push_back(c);
+        }
+    }
+
+    //then split into static and dynamic nodes, which keeps the depth order.
+    //parents are visited first so any static node below a dynamic one is
+    //already known to be dynamic by the time its children are checked
+    for (auto idx : m_sortBuffer)
+    {
+        auto& tx = transforms.at(idx);
+        if (tx.m_static
+            && tx.m_linkedParent > -1
+            && !transforms.at(tx.m_linkedParent).m_static)
+        {
+            tx.m_static = false;
+            LOG("Static transform is parented to a dynamic transform, it will be made dynamic", Logger::Type::Warning);
+        }
+
+        if (tx.m_static)
+        {
+            m_staticOrder.push_back(idx);
         }
-    };
-    
-    //remove all children when an entity dies
-    //TODO does this entity still exist by the time we get here?
-    if (msg.id == Message::SceneMessage)
+        else
+        {
+            m_order.push_back(idx);
+        }
+    }
+}
+
+void SceneGraph::resizeStamps(std::size_t size)
+{
+    m_updateStamps.resize(size, 0);
+    if (m_interpolate)
     {
-        const auto& data = msg.getData<Message::SceneEvent>();
-        auto entity = getScene()->getEntity(data.entityID);
-        if (entity.hasComponent<Transform>())
+        m_previousTransforms.resize(size);
+        m_currentTransforms.resize(size);
+    }
+}
+
+void SceneGraph::updateWorldValues(Transform& tx, const Transform& parent)
+{
+    //cache the decomposed values so consumers don't have to
+    tx.m_worldPosition = glm::vec3(tx.m_worldTransform * glm::vec4(tx.m_origin, 1.f));
+    tx.m_worldRotation = parent.getWorldRotation() * tx.m_rotation;
+    tx.m_worldScale = glm::vec3(glm::length(glm::vec3(tx.m_worldTransform[0])),
+        glm::length(glm::vec3(tx.m_worldTransform[1])),
+        glm::length(glm::vec3(tx.m_worldTransform[2])));
+}
+
+SceneGraph::LocalTransform SceneGraph::getLocal(const Transform& tx)
+{
+    LocalTransform retVal;
+    retVal.position = tx.m_position;
+    retVal.rotation = tx.m_rotation;
+    retVal.scale = tx.m_scale;
+    retVal.parent = tx.m_linkedParent;
+    return retVal;
+}
+
+void SceneGraph::beginInterpolation(float alpha)
+{
+    //only transforms which changed in the last step can differ from their
+    //previous value. They're in depth order, so parents are blended before
+    //their children are rebuilt from them. Everything is restored when
+    //rendering is done so the simulation never sees blended values
+    auto& transforms = getScene()->getComponentPool<Transform>();
+    m_savedTransforms.clear();
+    m_localTransforms->clear();
+    for (auto e : m_changedTransforms)
+    {
+        if (!transforms.contains(e.getIndex()))
         {
-            auto& children = entity.getComponent<Transform>().m_children;
-            destroyChildren(children);
+            continue;
+        }
+
+        auto& tx = transforms.at(e.getIndex());
+        auto& saved = m_savedTransforms.emplace_back();
+        saved.local = getLocal(tx);
+        saved.transform = tx.m_transform;
+        saved.worldTransform = tx.m_worldTransform;
+        saved.worldPosition = tx.m_worldPosition;
+        saved.worldRotation = tx.m_worldRotation;
+        saved.worldScale = tx.m_worldScale;
+
+        //a transform which changed parent is drawn where it is now
+        const auto& previous = m_previousTransforms[e.getIndex()];
+        const auto& current = m_currentTransforms[e.getIndex()];
+        const float amount = (previous.parent == current.parent) ? alpha : 1.f;
+
+        tx.m_position = glm::mix(previous.position, current.position, amount);
+        tx.m_rotation = glm::slerp(previous.rotation, current.rotation, amount);
+        tx.m_scale = glm::mix(previous.scale, current.scale, amount);
+        m_localTransforms->push(tx.m_position, tx.m_rotation, tx.m_scale, tx.m_origin, tx.m_transform);
+    }
+    m_localTransforms->composeLocal();
+
+    for (auto e : m_changedTransforms)
+    {
+        if (!transforms.contains(e.getIndex()))
+        {
+            continue;
+        }
+
+        auto& tx = transforms.at(e.getIndex());
+        if (tx.m_linkedParent > -1)
+        {
+            const auto& parent = transforms.at(tx.m_linkedParent);
+            Detail::TransformStore::multiply(parent.m_worldTransform, tx.m_transform, tx.m_worldTransform);
+            updateWorldValues(tx, parent);
+        }
+        else
+        {
+            tx.m_worldTransform = tx.m_transform;
         }
-        //LOG("Removing children from dead entity", Logger::Type::Info);
     }
 }
 
-//private
-void SceneGraph::onEntityAdded(Entity entity)
+void SceneGraph::endInterpolation()
 {
-    //nab our entity's index
-    entity.getComponent<Transform>().m_id = entity.getIndex();
+    auto& transforms = getScene()->getComponentPool<Transform>();
+    auto saved = m_savedTransforms.cbegin();
+    for (auto e : m_changedTransforms)
+    {
+        if (transforms.contains(e.getIndex()))
+        {
+            auto& tx = transforms.at(e.getIndex());
+            tx.m_position = saved->local.position;
+            tx.m_rotation = saved->local.rotation;
+            tx.m_scale = saved->local.scale;
+            tx.m_transform = saved->transform;
+            tx.m_worldTransform = saved->worldTransform;
+            tx.m_worldPosition = saved->worldPosition;
+            tx.m_worldRotation = saved->worldRotation;
+            tx.m_worldScale = saved->worldScale;
+            ++saved;
+        }
+    }
 }
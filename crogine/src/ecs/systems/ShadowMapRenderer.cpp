@@ -43,6 +43,8 @@ source distribution.
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 #include <crogine/detail/glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+
 using namespace cro;
 
 ShadowMapRenderer::ShadowMapRenderer(cro::MessageBus& mb)
@@ -84,9 +86,10 @@ void ShadowMapRenderer::process(cro::Time dt)
 void ShadowMapRenderer::render(Entity camera)
 {
     //enable face culling and render rear faces
-    glCheck(glEnable(GL_CULL_FACE));
-    glCheck(glCullFace(GL_FRONT));
-    glCheck(glEnable(GL_DEPTH_TEST));
+    m_renderState.reset();
+    m_renderState.setCapability(RenderState::CullFace, true);
+    m_renderState.setCullFace(GL_FRONT);
+    m_renderState.setCapability(RenderState::DepthTest, true);
     
     const auto& camTx = camera.getComponent<Transform>();
 
@@ -99,7 +102,11 @@ void ShadowMapRenderer::render(Entity camera)
 
     m_target.clear(cro::Colour::White());
 
-    
+    //the projection is the same for every draw so is only set once per shader
+    m_passShaders.clear();
+
+    uint32 currentVBO = 0;
+    const Material::Data* currentMaterial = nullptr;
     for (const auto& e : m_visibleEntities)
     {
         //calc entity transform
@@ -109,14 +116,19 @@ void ShadowMapRenderer::render(Entity camera)
 
         //foreach submesh / material:
         const auto& model = e.getComponent<Model>();
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo));
+        m_renderState.bindBuffer(GL_ARRAY_BUFFER, model.m_meshData.vbo);
 
         for (auto i = 0u; i < model.m_meshData.submeshCount; ++i)
         {
             const auto& mat = model.m_shadowMaterials[i];
 
             //bind shader
-            glCheck(glUseProgram(mat.shader));
+            m_renderState.useProgram(mat.shader);
+            if (std::find(m_passShaders.begin(), m_passShaders.end(), mat.shader) == m_passShaders.end())
+            {
+                m_passShaders.push_back(mat.shader);
+                glCheck(glUniformMatrix4fv(mat.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(projMat)));
+            }
 
             //apply shader uniforms from material
             for (auto j = 0u; j< mat.optionalUniformCount; ++j)
@@ -130,40 +142,42 @@ void ShadowMapRenderer::render(Entity camera)
                 }
             }
             glCheck(glUniformMatrix4fv(mat.uniforms[Material::WorldView], 1, GL_FALSE, glm::value_ptr(worldView)));
-            glCheck(glUniformMatrix4fv(mat.uniforms[Material::Projection], 1, GL_FALSE, glm::value_ptr(projMat)));
 
             //bind attribs
-            const auto& attribs = mat.attribs;
-            for (auto j = 0u; j < mat.attribCount; ++j)
+            if (currentVBO != model.m_meshData.vbo
+                || currentMaterial != &mat)
             {
-                glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
-                glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                    GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
-                    reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
+                currentVBO = model.m_meshData.vbo;
+                currentMaterial = &mat;
+
+                uint32 attribMask = 0;
+                const auto& attribs = mat.attribs;
+                for (auto j = 0u; j < mat.attribCount; ++j)
+                {
+                    attribMask |= (1u << attribs[j][Material::Data::Index]);
+                    glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
+                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                        reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
+                }
+                m_renderState.setVertexAttribs(attribMask);
             }
 
             //bind element/index buffer
             const auto& indexData = model.m_meshData.indexData[i];
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo));
+            m_renderState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexData.ibo);
 
             //draw elements
             glCheck(glDrawElements(static_cast<GLenum>(indexData.primitiveType), indexData.indexCount, static_cast<GLenum>(indexData.format), 0));
-
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-
-            //unbind attribs
-            for (auto j = 0u; j < mat.attribCount; ++j)
-            {
-                glCheck(glDisableVertexAttribArray(attribs[j][Material::Data::Index]));
-            }
         }
-        glCheck(glUseProgram(0));
     }
 
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-    glCheck(glDisable(GL_DEPTH_TEST));
-    glCheck(glDisable(GL_CULL_FACE));
-    glCheck(glCullFace(GL_BACK));
+    m_renderState.setVertexAttribs(0);
+    m_renderState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    m_renderState.bindBuffer(GL_ARRAY_BUFFER, 0);
+    m_renderState.useProgram(0);
+    m_renderState.setCapability(RenderState::DepthTest, false);
+    m_renderState.setCapability(RenderState::CullFace, false);
+    m_renderState.setCullFace(GL_BACK);
     m_target.display();
 }
 
@@ -31,96 +31,119 @@ source distribution.
 #include <crogine/core/App.hpp>
 #include <crogine/ecs/systems/SkeletalAnimator.hpp>
 #include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/Scene.hpp>
 
 #include <crogine/detail/glm/gtx/matrix_decompose.hpp>
 #include <crogine/detail/glm/gtx/quaternion.hpp>
 
 using namespace cro;
 
+namespace
+{
+    constexpr std::size_t GrainSize = 8;
+}
+
 SkeletalAnimator::SkeletalAnimator(MessageBus& mb)
     : System(mb, typeid(SkeletalAnimator))
 {
-    requireComponent<Model>();
+    requireComponent<Model>(Access::Read);
     requireComponent<Skeleton>();
+
+    setParallel(true);
 }
 
 //public
 void SkeletalAnimator::process(Time dt)
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities)
-    {      
-        //get skeleton
-        auto& skel = entity.getComponent<Skeleton>();
-
-        //update current frame if running
-        if (skel.nextAnimation < 0)
+    //skeletons are usually far fewer than models, so the view
+    //iterates the skeleton pool and looks up the model directly
+    m_skeletons.clear();
+    for (auto [skel, model] : getScene()->view<Skeleton, Model>())
+    {
+        m_skeletons.emplace_back(&skel, &model);
+    }
+
+    //skeletons are independent of each other so are split
+    //into batches and interpolated across the job system
+    App::getJobSystem().parallelFor(m_skeletons.size(), GrainSize,
+        [&, dt](std::size_t begin, std::size_t end)
+    {
+        for (auto j = begin; j < end; ++j)
         {
-            //update current animation
-            auto& anim = skel.animations[skel.currentAnimation];
-            if (anim.playing)
-            {
-                auto nextFrame = ((anim.currentFrame - anim.startFrame) + 1) % anim.frameCount;
-                nextFrame += anim.startFrame;
+            processSkeleton(*m_skeletons[j].first, *m_skeletons[j].second, dt);
+        }
+    });
+}
 
-                skel.currentFrameTime += dt.asSeconds();
-                              
-                if (entity.getComponent<Model>().isVisible())
-                {
-                    float interpTime = std::min(1.f, skel.currentFrameTime / skel.frameTime);
-                    interpolate(anim.currentFrame, nextFrame, interpTime, skel);
-                }
+//private
+void SkeletalAnimator::processSkeleton(Skeleton& skel, const Model& model, Time dt)
+{
+    //update current frame if running
+    if (skel.nextAnimation < 0)
+    {
+        //update current animation
+        auto& anim = skel.animations[skel.currentAnimation];
+        if (anim.playing)
+        {
+            auto nextFrame = ((anim.currentFrame - anim.startFrame) + 1) % anim.frameCount;
+            nextFrame += anim.startFrame;
 
-                if (skel.currentFrameTime > skel.frameTime)
-                {
-                    //frame is done, move to next
-                    if (nextFrame < anim.currentFrame && !anim.looped)
-                    {
-                        anim.playing = false;
-                    }
-
-                    anim.currentFrame = nextFrame;
-                    skel.currentFrameTime = 0.f;                  
-                }
-                //DPRINT("Current Frame", std::to_string(anim.currentFrame));
+            skel.currentFrameTime += dt.asSeconds();
+                          
+            if (model.isVisible())
+            {
+                float interpTime = std::min(1.f, skel.currentFrameTime / skel.frameTime);
+                interpolate(anim.currentFrame, nextFrame, interpTime, skel);
             }
-            else
+
+            if (skel.currentFrameTime > skel.frameTime)
             {
-                //show the current frame
-                if (entity.getComponent<Model>().isVisible())
+                //frame is done, move to next
+                if (nextFrame < anim.currentFrame && !anim.looped)
                 {
-                    interpolate(anim.currentFrame, anim.currentFrame, 0.f, skel);
+                    anim.playing = false;
                 }
+
+                anim.currentFrame = nextFrame;
+                skel.currentFrameTime = 0.f;                  
             }
+            //DPRINT("Current Frame", std::to_string(anim.currentFrame));
         }
         else
         {
-            //TODO blend to next animation
-            //this is a bit of a kludge which blends from the current frame to the
-            //first frame of the next anim. Really we should interpolate the current
-            //position of both animations, and then blend the results according to
-            //the current blend time.
-            skel.currentBlendTime += dt.asSeconds();
-            if (entity.getComponent<Model>().isVisible())
+            //show the current frame
+            if (model.isVisible())
             {
-                float interpTime = std::min(1.f, skel.currentBlendTime / skel.blendTime);
-                interpolate(skel.animations[skel.currentAnimation].currentFrame, skel.animations[skel.nextAnimation].startFrame, interpTime, skel);
+                interpolate(anim.currentFrame, anim.currentFrame, 0.f, skel);
             }
+        }
+    }
+    else
+    {
+        //TODO blend to next animation
+        //this is a bit of a kludge which blends from the current frame to the
+        //first frame of the next anim. Really we should interpolate the current
+        //position of both animations, and then blend the results according to
+        //the current blend time.
+        skel.currentBlendTime += dt.asSeconds();
+        if (model.isVisible())
+        {
+            float interpTime = std::min(1.f, skel.currentBlendTime / skel.blendTime);
+            interpolate(skel.animations[skel.currentAnimation].currentFrame, skel.animations[skel.nextAnimation].startFrame, interpTime, skel);
+        }
 
-            if (skel.currentBlendTime > skel.blendTime)
-            {
-                skel.animations[skel.currentAnimation].playing = false;
-                skel.currentAnimation = skel.nextAnimation;
-                skel.nextAnimation = -1;
-                skel.frameTime = 1.f / skel.animations[skel.currentAnimation].frameRate;
-                skel.currentFrameTime = 0.f;
-                skel.animations[skel.currentAnimation].playing = true;
-            }
+        if (skel.currentBlendTime > skel.blendTime)
+        {
+            skel.animations[skel.currentAnimation].playing = false;
+            skel.currentAnimation = skel.nextAnimation;
+            skel.nextAnimation = -1;
+            skel.frameTime = 1.f / skel.animations[skel.currentAnimation].frameRate;
+            skel.currentFrameTime = 0.f;
+            skel.animations[skel.currentAnimation].playing = true;
         }
     }
 }
 
-//private
 void SkeletalAnimator::onEntityAdded(Entity entity)
 {
     auto& skeleton = entity.getComponent<Skeleton>();
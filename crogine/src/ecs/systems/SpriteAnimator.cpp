@@ -41,6 +41,8 @@ SpriteAnimator::SpriteAnimator(MessageBus& mb)
 {
     requireComponent<Sprite>();
     requireComponent<SpriteAnimation>();
+
+    setParallel(true);
 }
 
 //public
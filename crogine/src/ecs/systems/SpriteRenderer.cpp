@@ -145,11 +145,6 @@ SpriteRenderer::~SpriteRenderer()
 }
 
 //public
-void SpriteRenderer::handleMessage(const Message& msg)
-{
-
-}
-
 void SpriteRenderer::process(Time)
 { 
     //have to do this first, at least once
@@ -270,6 +265,7 @@ void SpriteRenderer::process(Time)
 
             return false;
         });
+        entitiesReordered();
         m_pendingSorting = false;
     }
 }
@@ -280,11 +276,17 @@ void SpriteRenderer::render(Entity camera)
     applyViewport(camComponent.viewport);
     
     //bind shader and attrib arrays
-    glCheck(glUseProgram(m_shader.getGLHandle()));
+    m_renderState.reset();
+    m_renderState.useProgram(m_shader.getGLHandle());
     glCheck(glUniformMatrix4fv(m_projectionIndex, 1, GL_FALSE, glm::value_ptr(camComponent.viewProjectionMatrix)));
-    glCheck(glActiveTexture(GL_TEXTURE0));
     glCheck(glUniform1i(m_textureIndex, 0));
 
+    uint32 attribMask = 0;
+    for (const auto& attrib : m_attribMap)
+    {
+        attribMask |= (1u << attrib.location);
+    }
+
     //foreach vbo bind and draw
     std::size_t idx = 0;
     for (const auto& batch : m_buffers)
@@ -292,12 +294,12 @@ void SpriteRenderer::render(Entity camera)
         const auto& transforms = m_bufferTransforms[idx++]; //TODO this should be same index as current buffer
         glCheck(glUniformMatrix4fv(m_matrixIndex, static_cast<GLsizei>(transforms.size()), GL_FALSE, glm::value_ptr(transforms[0])));
 
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, batch.first));
+        m_renderState.bindBuffer(GL_ARRAY_BUFFER, batch.first);
         
         //bind attrib pointers
+        m_renderState.setVertexAttribs(attribMask);
         for (auto i = 0u; i < m_attribMap.size(); ++i)
         {
-            glCheck(glEnableVertexAttribArray(m_attribMap[i].location));
             glCheck(glVertexAttribPointer(m_attribMap[i].location, m_attribMap[i].size, GL_FLOAT, GL_FALSE, vertexSize, 
                 reinterpret_cast<void*>(static_cast<intptr_t>(m_attribMap[i].offset))));      
         }
@@ -306,24 +308,18 @@ void SpriteRenderer::render(Entity camera)
         {
             //CRO_ASSERT(batchData.texture > -1, "Missing sprite texture!");
             applyBlendMode(batchData.blendMode);
-            glCheck(glBindTexture(GL_TEXTURE_2D, batchData.texture));
+            m_renderState.bindTexture(0, batchData.texture);
             glCheck(glDrawArrays(GL_TRIANGLE_STRIP, batchData.start, batchData.count));
         }
-  
-        //unbind attrib pointers
-        for (auto i = 0u; i < m_attribMap.size(); ++i)
-        {
-            glCheck(glDisableVertexAttribArray(m_attribMap[i].location));
-        } 
-
     }
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
+    m_renderState.setVertexAttribs(0);
+    m_renderState.bindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glCheck(glDisable(GL_DEPTH_TEST));
-    glCheck(glDisable(GL_CULL_FACE));
-    glCheck(glDisable(GL_BLEND));
-    glCheck(glDepthMask(GL_TRUE));
+    m_renderState.setCapability(RenderState::DepthTest, false);
+    m_renderState.setCapability(RenderState::CullFace, false);
+    m_renderState.setCapability(RenderState::Blend, false);
+    m_renderState.setDepthMask(true);
 
     restorePreviousViewport();
 }
@@ -496,34 +492,34 @@ void SpriteRenderer::applyBlendMode(Material::BlendMode mode)
     {
     default: break;
     case Material::BlendMode::Additive:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glBlendFunc(GL_ONE, GL_ONE));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(false);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setBlendFunc(GL_ONE, GL_ONE);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Alpha:
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(false);
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Multiply:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_FALSE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(false);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setBlendFunc(GL_DST_COLOR, GL_ZERO);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::None:
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glDisable(GL_BLEND));
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(true);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setCapability(RenderState::Blend, false);
         break;
     }
 }
@@ -537,4 +533,5 @@ void SpriteRenderer::onEntityAdded(Entity entity)
 void SpriteRenderer::onEntityRemoved(Entity entity)
 {
     m_pendingRebuild = true;
+    m_pendingSorting = true; //removal doesn't preserve the order of the entity list
 }
@@ -86,11 +86,6 @@ TextRenderer::~TextRenderer()
 }
 
 //public
-void TextRenderer::handleMessage(const Message& msg)
-{
-
-}
-
 void TextRenderer::process(Time dt)
 {
     if (m_pendingRebuild)
@@ -180,6 +175,7 @@ void TextRenderer::process(Time dt)
 
             return false;
         });
+        entitiesReordered();
 
         m_pendingRebuild = true;
     }
@@ -191,11 +187,17 @@ void TextRenderer::render(Entity camera)
     m_currentViewport = applyViewport(camComponent.viewport);
 
     //bind shader and attrib arrays - TODO do this for both shader types
-    glCheck(glUseProgram(m_shaders[Font::Bitmap].shader.getGLHandle()));
+    m_renderState.reset();
+    m_renderState.useProgram(m_shaders[Font::Bitmap].shader.getGLHandle());
     glCheck(glUniformMatrix4fv(m_shaders[Font::Bitmap].projectionUniformIndex, 1, GL_FALSE, &camComponent.viewProjectionMatrix[0][0]));
-    glCheck(glActiveTexture(GL_TEXTURE0));
     glCheck(glUniform1i(m_shaders[Font::Bitmap].textureUniformIndex, 0));
 
+    uint32 attribMask = 0;
+    for (const auto& attrib : m_shaders[Font::Bitmap].attribMap)
+    {
+        attribMask |= (1u << attrib.location);
+    }
+
     //foreach vbo bind and draw
     std::size_t idx = 0;
     for (const auto& batch : m_buffers)
@@ -203,12 +205,12 @@ void TextRenderer::render(Entity camera)
         const auto& transforms = m_bufferTransforms[idx++]; //TODO this should be same index as current buffer
         glCheck(glUniformMatrix4fv(m_shaders[Font::Bitmap].xformUniformIndex, static_cast<GLsizei>(transforms.size()), GL_FALSE, glm::value_ptr(transforms[0])));
 
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, batch.first));
+        m_renderState.bindBuffer(GL_ARRAY_BUFFER, batch.first);
 
         //bind attrib pointers
+        m_renderState.setVertexAttribs(attribMask);
         for (auto i = 0u; i < m_shaders[Font::Bitmap].attribMap.size(); ++i)
         {
-            glCheck(glEnableVertexAttribArray(m_shaders[Font::Bitmap].attribMap[i].location));
             glCheck(glVertexAttribPointer(m_shaders[Font::Bitmap].attribMap[i].location, m_shaders[Font::Bitmap].attribMap[i].size, GL_FLOAT, GL_FALSE, vertexSize,
                 reinterpret_cast<void*>(static_cast<intptr_t>(m_shaders[Font::Bitmap].attribMap[i].offset))));
         }
@@ -222,26 +224,21 @@ void TextRenderer::render(Entity camera)
             {
                 applyScissor(batchData.worldScissor, camComponent.viewProjectionMatrix);
             }
+            m_renderState.setCapability(RenderState::ScissorTest, batchData.scissor);
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, batchData.texture));
+            m_renderState.bindTexture(0, batchData.texture);
             glCheck(glDrawArrays(GL_TRIANGLE_STRIP, batchData.start, batchData.count));
-            glCheck(glDisable(GL_SCISSOR_TEST));
-        }
-
-        //unbind attrib pointers
-        for (auto i = 0u; i < m_shaders[Font::Bitmap].attribMap.size(); ++i)
-        {
-            glCheck(glDisableVertexAttribArray(m_shaders[Font::Bitmap].attribMap[i].location));
         }
-
     }
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
+    m_renderState.setVertexAttribs(0);
+    m_renderState.bindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glCheck(glDisable(GL_DEPTH_TEST));
-    glCheck(glDisable(GL_CULL_FACE));
-    glCheck(glDisable(GL_BLEND));
-    glCheck(glDepthMask(GL_TRUE));
+    m_renderState.setCapability(RenderState::ScissorTest, false);
+    m_renderState.setCapability(RenderState::DepthTest, false);
+    m_renderState.setCapability(RenderState::CullFace, false);
+    m_renderState.setCapability(RenderState::Blend, false);
+    m_renderState.setDepthMask(true);
     
     restorePreviousViewport();
 }
@@ -551,33 +548,33 @@ void TextRenderer::applyBlendMode(Material::BlendMode mode)
     {
     default: break;
     case Material::BlendMode::Additive:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glBlendFunc(GL_ONE, GL_ONE));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(true);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setBlendFunc(GL_ONE, GL_ONE);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Alpha:
-        glCheck(glEnable(GL_CULL_FACE));
-        //glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::CullFace, true);
+        //m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::Multiply:
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glBlendFunc(GL_DST_COLOR, GL_ZERO));
-        glCheck(glBlendEquation(GL_FUNC_ADD));
+        m_renderState.setCapability(RenderState::Blend, true);
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(true);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setBlendFunc(GL_DST_COLOR, GL_ZERO);
+        m_renderState.setBlendEquation(GL_FUNC_ADD);
         break;
     case Material::BlendMode::None:
-        glCheck(glEnable(GL_DEPTH_TEST));
-        glCheck(glDepthMask(GL_TRUE));
-        glCheck(glEnable(GL_CULL_FACE));
-        glCheck(glDisable(GL_BLEND));
+        m_renderState.setCapability(RenderState::DepthTest, true);
+        m_renderState.setDepthMask(true);
+        m_renderState.setCapability(RenderState::CullFace, true);
+        m_renderState.setCapability(RenderState::Blend, false);
         break;
     }
 }
@@ -605,7 +602,6 @@ void TextRenderer::applyScissor(const FloatRect& worldBox, const glm::mat4& view
     //DPRINT("Scissor Post", std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(w) + ", " + std::to_string(h));
 
     glCheck(glScissor(x, y, w, h));
-    glCheck(glEnable(GL_SCISSOR_TEST));
     //LOG("Scissor Applied", Logger::Type::Info);
 }
 
@@ -620,4 +616,5 @@ void TextRenderer::onEntityAdded(Entity entity)
 void TextRenderer::onEntityRemoved(Entity)
 {
     m_pendingRebuild = true;
+    m_pendingSorting = true; //removal doesn't preserve the order of the entity list
 }
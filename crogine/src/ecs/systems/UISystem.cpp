@@ -51,6 +51,8 @@ UISystem::UISystem(MessageBus& mb)
     m_movementCallbacks.push_back([](Entity, glm::vec2) {});
 
     m_windowSize = App::getWindow().getSize();
+
+    subscribe(Message::WindowMessage);
 }
 
 void UISystem::handleEvent(const Event& evt)
@@ -42,6 +42,41 @@ using namespace cro::Material;
 
 namespace
 {
+    //FNV-1a
+    uint64 hashBytes(uint64 hash, const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (auto i = 0u; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    //the hash of each property is xor'd with the material's hash, so the
+    //order of the property list doesn't matter, and a property's old value
+    //can be removed from the hash by xoring it again
+    uint64 hashProperty(const std::string& name, const Property& property)
+    {
+        std::size_t size = 0;
+        switch (property.type)
+        {
+        default:
+        case Property::None: return 0;
+        case Property::Number: size = sizeof(float); break;
+        case Property::Vec2: size = sizeof(float) * 2; break;
+        case Property::Vec3: size = sizeof(float) * 3; break;
+        case Property::Vec4: size = sizeof(float) * 4; break;
+        case Property::Mat4: size = sizeof(glm::mat4); break;
+        case Property::Texture: size = sizeof(int32); break;
+        }
+
+        auto hash = hashBytes(14695981039346656037ull, name.data(), name.size());
+        hash = hashBytes(hash, &property.type, sizeof(property.type));
+        return hashBytes(hash, &property.numberValue, size);
+    }
+
 #ifdef CRO_DEBUG_
     void exists(const std::string& name, const Material::PropertyList& properties)
     {
@@ -67,8 +102,10 @@ void Data::setProperty(const std::string& name, float value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         result->second.second.numberValue = value;
         result->second.second.type = Property::Number;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
 
@@ -78,11 +115,13 @@ void Data::setProperty(const std::string& name, glm::vec2 value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         //result->second.second.lastVecValue[0] = result->second.second.vecValue[0];
         //result->second.second.lastVecValue[1] = result->second.second.vecValue[1];
         result->second.second.vecValue[0] = value.x;
         result->second.second.vecValue[1] = value.y;
         result->second.second.type = Property::Vec2;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
 
@@ -92,10 +131,12 @@ void Data::setProperty(const std::string& name, glm::vec3 value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         result->second.second.vecValue[0] = value.x;
         result->second.second.vecValue[1] = value.y;
         result->second.second.vecValue[2] = value.z;
         result->second.second.type = Property::Vec3;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
 
@@ -105,11 +146,13 @@ void Data::setProperty(const std::string& name, glm::vec4 value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         result->second.second.vecValue[0] = value.x;
         result->second.second.vecValue[1] = value.y;
         result->second.second.vecValue[2] = value.z;
         result->second.second.vecValue[3] = value.w;
         result->second.second.type = Property::Vec4;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
 
@@ -118,8 +161,10 @@ void Data::setProperty(const std::string& name, glm::mat4 value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         result->second.second.matrixValue = value;
         result->second.second.type = Property::Mat4;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
 
@@ -129,11 +174,13 @@ void Data::setProperty(const std::string& name, Colour value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         result->second.second.vecValue[0] = value.getRed();
         result->second.second.vecValue[1] = value.getGreen();
         result->second.second.vecValue[2] = value.getBlue();
         result->second.second.vecValue[3] = value.getAlpha();
         result->second.second.type = Property::Vec4;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
 
@@ -143,7 +190,9 @@ void Data::setProperty(const std::string& name, const Texture& value)
     auto result = properties.find(name);
     if (result != properties.end())
     {
+        propertyHash ^= hashProperty(name, result->second.second);
         result->second.second.textureID = value.getGLHandle();
         result->second.second.type = Property::Texture;
+        propertyHash ^= hashProperty(name, result->second.second);
     }
 }
\ No newline at end of file
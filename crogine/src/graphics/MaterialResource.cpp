@@ -51,6 +51,7 @@ Material::Data& MaterialResource::add(int32 ID, const Shader& shader)
 
     Material::Data data;
     data.shader = shader.getGLHandle();
+    data.id = ID;
 
     //get the available attribs. This is sorted and culled
     //when added to a model according to the requirements of
@@ -60,6 +61,7 @@ Material::Data& MaterialResource::add(int32 ID, const Shader& shader)
     {
         data.attribs[i][Material::Data::Index] = shaderAttribs[i];
     }
+    data.instanceAttribs = shader.getInstanceAttribMap();
 
     //check the shader for standard uniforms and map them if they exist
     const auto& uniformMap = shader.getUniformMap();
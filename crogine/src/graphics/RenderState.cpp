@@ -0,0 +1,252 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#include <crogine/graphics/RenderState.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include "../detail/GLCheck.hpp"
+
+using namespace cro;
+
+namespace
+{
+    //no valid GL handle or enum has this value
+    const uint32 Unknown = 0xffffffff;
+
+    RenderState::Stats currentStats;
+    RenderState::Stats lastStats;
+
+    const std::array<GLenum, RenderState::CapabilityCount> capabilityEnums =
+    {
+        GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST
+    };
+}
+
+RenderState::RenderState()
+    : m_program         (Unknown),
+    m_arrayBuffer       (Unknown),
+    m_elementBuffer     (Unknown),
+    m_activeTextureUnit (Unknown),
+    m_depthMask         (-1),
+    m_cullFace          (Unknown),
+    m_blendSource       (Unknown),
+    m_blendDestination  (Unknown),
+    m_blendEquation     (Unknown),
+    m_vertexAttribs     (0),
+    m_attribDivisors    (0)
+{
+    m_textures.fill(Unknown);
+    m_capabilities.fill(-1);
+}
+
+//public
+void RenderState::reset()
+{
+    m_program = Unknown;
+    m_arrayBuffer = Unknown;
+    m_elementBuffer = Unknown;
+    m_activeTextureUnit = Unknown;
+    m_textures.fill(Unknown);
+    m_capabilities.fill(-1);
+    m_depthMask = -1;
+    m_cullFace = Unknown;
+    m_blendSource = Unknown;
+    m_blendDestination = Unknown;
+    m_blendEquation = Unknown;
+    m_vertexAttribs = 0;
+    m_attribDivisors = 0;
+}
+
+void RenderState::useProgram(uint32 program)
+{
+    if (changed(m_program, program))
+    {
+        glCheck(glUseProgram(program));
+    }
+}
+
+void RenderState::bindBuffer(uint32 target, uint32 buffer)
+{
+    CRO_ASSERT(target == GL_ARRAY_BUFFER || target == GL_ELEMENT_ARRAY_BUFFER, "Unsupported buffer target");
+    auto& current = (target == GL_ARRAY_BUFFER) ? m_arrayBuffer : m_elementBuffer;
+    if (changed(current, buffer))
+    {
+        glCheck(glBindBuffer(target, buffer));
+    }
+}
+
+void RenderState::bindTexture(uint32 unit, uint32 texture)
+{
+    CRO_ASSERT(unit < MaxTextureUnits, "Texture unit out of range");
+    if (m_textures[unit] == texture)
+    {
+        currentStats.skipped++;
+        return;
+    }
+
+    if (changed(m_activeTextureUnit, unit))
+    {
+        glCheck(glActiveTexture(GL_TEXTURE0 + unit));
+    }
+
+    m_textures[unit] = texture;
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+    currentStats.issued++;
+}
+
+void RenderState::setCapability(Capability capability, bool enabled)
+{
+    if (changed(m_capabilities[capability], enabled ? 1 : 0))
+    {
+        if (enabled)
+        {
+            glCheck(glEnable(capabilityEnums[capability]));
+        }
+        else
+        {
+            glCheck(glDisable(capabilityEnums[capability]));
+        }
+    }
+}
+
+void RenderState::setDepthMask(bool enabled)
+{
+    if (changed(m_depthMask, enabled ? 1 : 0))
+    {
+        glCheck(glDepthMask(enabled ? GL_TRUE : GL_FALSE));
+    }
+}
+
+void RenderState::setCullFace(uint32 face)
+{
+    if (changed(m_cullFace, face))
+    {
+        glCheck(glCullFace(face));
+    }
+}
+
+void RenderState::setBlendFunc(uint32 source, uint32 destination)
+{
+    if (m_blendSource == source && m_blendDestination == destination)
+    {
+        currentStats.skipped++;
+        return;
+    }
+
+    m_blendSource = source;
+    m_blendDestination = destination;
+    glCheck(glBlendFunc(source, destination));
+    currentStats.issued++;
+}
+
+void RenderState::setBlendEquation(uint32 equation)
+{
+    if (changed(m_blendEquation, equation))
+    {
+        glCheck(glBlendEquation(equation));
+    }
+}
+
+void RenderState::setVertexAttribs(uint32 mask)
+{
+    auto attribs = m_vertexAttribs | mask;
+    for (auto i = 0u; attribs != 0; ++i, attribs >>= 1)
+    {
+        if (attribs & 1)
+        {
+            const auto bit = 1u << i;
+            if ((m_vertexAttribs & bit) == (mask & bit))
+            {
+                currentStats.skipped++;
+            }
+            else
+            {
+                if (mask & bit)
+                {
+                    glCheck(glEnableVertexAttribArray(i));
+                }
+                else
+                {
+                    glCheck(glDisableVertexAttribArray(i));
+                }
+                currentStats.issued++;
+            }
+        }
+    }
+    m_vertexAttribs = mask;
+}
+
+void RenderState::setAttribDivisors(uint32 mask)
+{
+    CRO_ASSERT(mask == 0 || glVertexAttribDivisor, "Instancing not supported");
+
+    auto attribs = m_attribDivisors | mask;
+    for (auto i = 0u; attribs != 0; ++i, attribs >>= 1)
+    {
+        if (attribs & 1)
+        {
+            const auto bit = 1u << i;
+            if ((m_attribDivisors & bit) == (mask & bit))
+            {
+                currentStats.skipped++;
+            }
+            else
+            {
+                glCheck(glVertexAttribDivisor(i, (mask & bit) ? 1 : 0));
+                currentStats.issued++;
+            }
+        }
+    }
+    m_attribDivisors = mask;
+}
+
+RenderState::Stats RenderState::getLastFrameStats()
+{
+    return lastStats;
+}
+
+void RenderState::endFrame()
+{
+    lastStats = currentStats;
+    currentStats = {};
+}
+
+//private
+template <typename T>
+bool RenderState::changed(T& current, T value)
+{
+    if (current == value)
+    {
+        currentStats.skipped++;
+        return false;
+    }
+    current = value;
+    currentStats.issued++;
+    return true;
+}
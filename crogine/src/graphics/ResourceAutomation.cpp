@@ -268,6 +268,14 @@ bool ModelDefinition::loadFromFile(const std::string& path, ResourceCollection&
                     flags |= ShaderResource::RxShadows;
                 }
             }
+            else if (name == "instanced")
+            {
+                //models created from this definition may be batched
+                if (p.getValue<bool>())
+                {
+                    flags |= ShaderResource::Instancing;
+                }
+            }
             else if (name == "smooth")
             {
                 smoothTextures = p.getValue<bool>();
@@ -278,6 +286,12 @@ bool ModelDefinition::loadFromFile(const std::string& path, ResourceCollection&
             }
         }
 
+        //each skinned model has its own pose so can't be instanced
+        if (flags & ShaderResource::Skinning)
+        {
+            flags &= ~ShaderResource::Instancing;
+        }
+
         //load the material then check properties again for material properties
         auto shaderID = rc.shaders.preloadBuiltIn(shaderType, flags);
         auto matID = rc.materials.add(rc.shaders.get(shaderID));
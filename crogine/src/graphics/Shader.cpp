@@ -52,8 +52,9 @@ namespace
 }
 
 Shader::Shader()
-    : m_handle  (0),
-    m_attribMap ({})
+    : m_handle          (0),
+    m_attribMap         ({}),
+    m_instanceAttribMap ({})
 {
     resetAttribMap();
 }
@@ -62,10 +63,12 @@ Shader::Shader(Shader&& other)
 {
     m_handle = other.m_handle;
     m_attribMap = other.m_attribMap;
+    m_instanceAttribMap = other.m_instanceAttribMap;
     m_uniformMap = other.m_uniformMap;
 
     other.m_handle = 0;
     other.m_attribMap = {};
+    other.m_instanceAttribMap = {};
     other.m_uniformMap.clear();
 }
 
@@ -75,10 +78,13 @@ Shader& Shader::operator=(Shader&& other)
     {
         m_handle = other.m_handle;
         m_attribMap = other.m_attribMap;
+        m_instanceAttribMap = other.m_instanceAttribMap;
         m_uniformMap = other.m_uniformMap;
 
         other.m_handle = 0;
         other.m_attribMap = {};
+        other.m_instanceAttribMap = {};
+    other.m_instanceAttribMap = {};
         other.m_uniformMap.clear();
     }
     return *this;
@@ -225,6 +231,11 @@ const std::array<int32, Mesh::Attribute::Total>& Shader::getAttribMap() const
     return m_attribMap;
 }
 
+const std::array<int32, Mesh::InstanceAttribute::InstanceTotal>& Shader::getInstanceAttribMap() const
+{
+    return m_instanceAttribMap;
+}
+
 const std::unordered_map<std::string, int32>& Shader::getUniformMap() const
 {
     return m_uniformMap;
@@ -289,6 +300,15 @@ bool Shader::fillAttribMap()
                 {
                     m_attribMap[Mesh::BlendWeights] = attribLocation;
                 }
+                //matrix attributes take up one location per column
+                else if (name == "a_instanceWorldMatrix")
+                {
+                    m_instanceAttribMap[Mesh::InstanceWorldMatrix] = attribLocation;
+                }
+                else if (name == "a_instanceNormalMatrix")
+                {
+                    m_instanceAttribMap[Mesh::InstanceNormalMatrix] = attribLocation;
+                }
                 else
                 {
                     Logger::log(name + ": unknown vertex attribute. Shader compilation failed.", Logger::Type::Error);
@@ -307,6 +327,7 @@ bool Shader::fillAttribMap()
 void Shader::resetAttribMap()
 {
     std::memset(m_attribMap.data(), -1, m_attribMap.size() * sizeof(int32));
+    std::memset(m_instanceAttribMap.data(), -1, m_instanceAttribMap.size() * sizeof(int32));
 }
 
 void Shader::fillUniformMap()
@@ -129,6 +129,11 @@ int32 ShaderResource::preloadBuiltIn(BuiltIn type, int32 flags)
     {
         defines += "\n#define RX_SHADOWS";
     }
+    if (flags & BuiltInFlags::Instancing)
+    {
+        CRO_ASSERT((flags & BuiltInFlags::Skinning) == 0, "Skinned models can't be instanced");
+        defines += "\n#define INSTANCING";
+    }
     if (flags & BuiltInFlags::Skinning)
     {
         if (MAX_BONES == 0)
@@ -62,8 +62,13 @@ namespace cro
                 uniform LOW int u_projectionMapCount; //how many to actually draw
                 #endif
 
+                #if defined(INSTANCING)
+                attribute mat4 a_instanceWorldMatrix;
+                uniform mat4 u_viewMatrix;
+                #else
                 uniform mat4 u_worldMatrix;
-                uniform mat4 u_worldViewMatrix;               
+                uniform mat4 u_worldViewMatrix;
+                #endif
                 uniform mat4 u_projectionMatrix;
 
                 #if defined(RX_SHADOWS)
@@ -94,13 +99,21 @@ namespace cro
 
                 void main()
                 {
-                    mat4 wvp = u_projectionMatrix * u_worldViewMatrix;
+                #if defined(INSTANCING)
+                    mat4 worldMatrix = a_instanceWorldMatrix;
+                    mat4 worldViewMatrix = u_viewMatrix * worldMatrix;
+                #else
+                    mat4 worldMatrix = u_worldMatrix;
+                    mat4 worldViewMatrix = u_worldViewMatrix;
+                #endif
+
+                    mat4 wvp = u_projectionMatrix * worldViewMatrix;
                     vec4 position = a_position;
 
                 #if defined(PROJECTIONS)
                     for(int i = 0; i < u_projectionMapCount; ++i)
                     {
-                        v_projectionCoords[i] = u_projectionMapMatrix[i] * u_worldMatrix * a_position;
+                        v_projectionCoords[i] = u_projectionMapMatrix[i] * worldMatrix * a_position;
                     }
                 #endif
 
@@ -116,7 +129,7 @@ namespace cro
                     gl_Position = wvp * position;
 
                 #if defined (RX_SHADOWS)
-                    v_lightWorldPosition = u_lightViewProjectionMatrix * u_worldMatrix * position;
+                    v_lightWorldPosition = u_lightViewProjectionMatrix * worldMatrix * position;
                 #endif
 
                 #if defined (VERTEX_COLOUR)
@@ -66,9 +66,15 @@ namespace cro
                 uniform LOW int u_projectionMapCount; //how many to actually draw
                 #endif
 
+                #if defined(INSTANCING)
+                attribute mat4 a_instanceWorldMatrix;
+                attribute mat3 a_instanceNormalMatrix;
+                uniform mat4 u_viewMatrix;
+                #else
                 uniform mat4 u_worldMatrix;
                 uniform mat4 u_worldViewMatrix;
-                uniform mat3 u_normalMatrix;                
+                uniform mat3 u_normalMatrix;
+                #endif
                 uniform mat4 u_projectionMatrix;
 
                 #if defined(RX_SHADOWS)
@@ -101,13 +107,23 @@ namespace cro
 
                 void main()
                 {
-                    mat4 wvp = u_projectionMatrix * u_worldViewMatrix;
+                #if defined(INSTANCING)
+                    mat4 worldMatrix = a_instanceWorldMatrix;
+                    mat4 worldViewMatrix = u_viewMatrix * worldMatrix;
+                    mat3 normalMatrix = a_instanceNormalMatrix;
+                #else
+                    mat4 worldMatrix = u_worldMatrix;
+                    mat4 worldViewMatrix = u_worldViewMatrix;
+                    mat3 normalMatrix = u_normalMatrix;
+                #endif
+
+                    mat4 wvp = u_projectionMatrix * worldViewMatrix;
                     vec4 position = a_position;
 
                 #if defined(PROJECTIONS)
                     for(int i = 0; i < u_projectionMapCount; ++i)
                     {
-                        v_projectionCoords[i] = u_projectionMapMatrix[i] * u_worldMatrix * a_position;
+                        v_projectionCoords[i] = u_projectionMapMatrix[i] * worldMatrix * a_position;
                     }
                 #endif
 
@@ -123,10 +139,10 @@ namespace cro
                     gl_Position = wvp * position;
 
                 #if defined (RX_SHADOWS)
-                    v_lightWorldPosition = u_lightViewProjectionMatrix * u_worldMatrix * position;
+                    v_lightWorldPosition = u_lightViewProjectionMatrix * worldMatrix * position;
                 #endif
 
-                    v_worldPosition = (u_worldMatrix * a_position).xyz;
+                    v_worldPosition = (worldMatrix * a_position).xyz;
                 #if defined(VERTEX_COLOUR)
                     v_colour = a_colour;
                 #endif
@@ -144,11 +160,11 @@ namespace cro
                     tangent = skinMatrix * tangent;
                     bitangent = skinMatrix * bitangent;
                 #endif
-                    v_tbn[0] = normalize(u_worldMatrix * tangent).xyz;
-                    v_tbn[1] = normalize(u_worldMatrix * bitangent).xyz;
-                    v_tbn[2] = normalize(u_worldMatrix * vec4(normal, 0.0)).xyz;
+                    v_tbn[0] = normalize(worldMatrix * tangent).xyz;
+                    v_tbn[1] = normalize(worldMatrix * bitangent).xyz;
+                    v_tbn[2] = normalize(worldMatrix * vec4(normal, 0.0)).xyz;
                 #else
-                    v_normalVector = u_normalMatrix * normal;
+                    v_normalVector = normalMatrix * normal;
                 #endif
 
                 #if defined(TEXTURED)
@@ -0,0 +1,246 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//times CommandSystem dispatch of commands targeting one or several of
+//the CommandTarget flags, both with and without entities being created
+//and destroyed each frame, against testing the flags of every entity.
+//Returns non-zero if any command visits the wrong entities
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/CommandID.hpp>
+#include <crogine/ecs/systems/CommandSystem.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    constexpr std::size_t EntityCount = 20000;
+    constexpr std::size_t FlagCount = 16;
+    constexpr std::size_t ChurnCount = 200; //entities replaced each frame
+    constexpr int Frames = 100;
+    constexpr int Runs = 3;
+
+    uint32 randomID(std::mt19937& rng)
+    {
+        //mostly single flags, as most targets are a single type
+        std::uniform_int_distribution<uint32> flag(0, FlagCount - 1);
+        std::uniform_int_distribution<int> extra(0, 9);
+        uint32 id = (1u << flag(rng));
+        if (extra(rng) == 0)
+        {
+            id |= (1u << flag(rng));
+        }
+        return id;
+    }
+
+    Entity createTarget(Scene& scene, uint32 id)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<CommandTarget>().ID = id;
+        return entity;
+    }
+
+    //sends one command per flag, plus one targeting several flags
+    void sendCommands(CommandSystem& cs, std::size_t& visits)
+    {
+        for (auto i = 0u; i < FlagCount; ++i)
+        {
+            Command cmd;
+            cmd.targetFlags = (1u << i);
+            cmd.action = [&visits](Entity, Time) { visits++; };
+            cs.sendCommand(std::move(cmd));
+        }
+
+        Command cmd;
+        cmd.targetFlags = 0x0f0f;
+        cmd.action = [&visits](Entity, Time) { visits++; };
+        cs.sendCommand(std::move(cmd));
+    }
+
+    //the number of visits sendCommands() should make to the given entities
+    std::size_t expectedVisits(const std::vector<Entity>& entities)
+    {
+        std::size_t retVal = 0;
+        for (auto e : entities)
+        {
+            auto id = e.getComponent<CommandTarget>().ID;
+            for (auto i = 0u; i < FlagCount; ++i)
+            {
+                if (id & (1u << i))
+                {
+                    retVal++;
+                }
+            }
+
+            if (id & 0x0f0f)
+            {
+                retVal++;
+            }
+        }
+        return retVal;
+    }
+
+    //checks a single command reaches exactly the entities with the given flags
+    bool visitsMatch(Scene& scene, CommandSystem& cs, const std::vector<Entity>& entities, uint32 flags)
+    {
+        std::vector<int> visits(EntityCount * 2);
+        Command cmd;
+        cmd.targetFlags = flags;
+        cmd.action = [&visits](Entity e, Time) { visits[e.getIndex()]++; };
+        cs.sendCommand(std::move(cmd));
+        scene.simulate(Time());
+
+        for (auto e : entities)
+        {
+            const int expected = (e.getComponent<CommandTarget>().ID & flags) ? 1 : 0;
+            if (visits[e.getIndex()] != expected)
+            {
+                return false;
+            }
+            visits[e.getIndex()] = 0;
+        }
+
+        //anything left over was visited but isn't a live target
+        for (auto v : visits)
+        {
+            if (v != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    MessageBus mb;
+    Scene scene(mb);
+    auto& cs = scene.addSystem<CommandSystem>(mb);
+
+    std::mt19937 rng(1234);
+    std::vector<Entity> entities;
+    for (auto i = 0u; i < EntityCount; ++i)
+    {
+        entities.push_back(createTarget(scene, randomID(rng)));
+    }
+    scene.simulate(Time());
+
+    check(visitsMatch(scene, cs, entities, 0x1), "single flag command");
+    check(visitsMatch(scene, cs, entities, 0x0f0f), "multiple flag command visits each target once");
+
+    //IDs modified at run time
+    entities[0].getComponent<CommandTarget>().ID = 0x2;
+    entities[1].getComponent<CommandTarget>().ID = 0;
+    auto idle = createTarget(scene, 0);
+    scene.simulate(Time());
+    idle.getComponent<CommandTarget>().ID = 0x3;
+    cs.updateTarget(entities[0]);
+    cs.updateTarget(entities[1]);
+    cs.updateTarget(idle);
+    entities.push_back(idle);
+    check(visitsMatch(scene, cs, entities, 0x3), "updated targets");
+
+    //destroyed entities are no longer visited, even if their index is reused
+    for (auto i = 0u; i < 10; ++i)
+    {
+        scene.destroyEntity(entities[i]);
+    }
+    entities.erase(entities.begin(), entities.begin() + 10);
+    scene.simulate(Time());
+    for (auto i = 0u; i < 10; ++i)
+    {
+        entities.push_back(createTarget(scene, 0x1));
+    }
+    check(visitsMatch(scene, cs, entities, 0xffff), "destroyed and reused targets");
+
+    std::size_t visits = 0;
+    auto dispatchTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                sendCommands(cs, visits);
+                scene.simulate(Time());
+            }
+        });
+    check(visits == expectedVisits(entities) * Frames * Runs, "dispatch visits");
+
+    std::uniform_int_distribution<std::size_t> pick(0, EntityCount - 1);
+    auto churnTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                for (auto j = 0u; j < ChurnCount; ++j)
+                {
+                    auto& e = entities[pick(rng)];
+                    scene.destroyEntity(e);
+                    e = createTarget(scene, randomID(rng));
+                }
+                sendCommands(cs, visits);
+                scene.simulate(Time());
+            }
+        });
+    check(visitsMatch(scene, cs, entities, 0xffff), "targets after churn");
+
+    //every command tests the ID of every entity
+    visits = 0;
+    auto allTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                for (auto f = 0u; f <= FlagCount; ++f)
+                {
+                    const uint32 flags = (f == FlagCount) ? 0x0f0f : (1u << f);
+                    for (auto e : entities)
+                    {
+                        if (e.getComponent<CommandTarget>().ID & flags)
+                        {
+                            visits++;
+                        }
+                    }
+                }
+            }
+        });
+    check(visits == expectedVisits(entities) * Frames * Runs, "testing every entity visits");
+
+    std::printf("%zu targets, %zu flags, %d frames\n", EntityCount, FlagCount, Frames);
+    test::report("bucketed dispatch", dispatchTime);
+    test::report("bucketed dispatch with churn", churnTime);
+    test::report("testing every entity", allTime);
+
+    return test::failures == 0 ? 0 : 1;
+}
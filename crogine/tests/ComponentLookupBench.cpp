@@ -0,0 +1,212 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//compares the cost of looking up components by type with the cached
+//component IDs and static_cast pool access against the previous
+//per-call type_index search and dynamic_cast. Returns non-zero if the
+//lookups disagree
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Entity.hpp>
+#include <crogine/core/MessageBus.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    constexpr std::size_t EntityCount = 10000;
+    constexpr int Iterations = 20;
+    constexpr int Runs = 5;
+
+    template <int N>
+    struct TestComponent final
+    {
+        float value = static_cast<float>(N);
+    };
+
+    //the ID lookup as it was before the IDs were cached
+    std::vector<std::type_index> legacyIDs;
+    std::mutex legacyMutex;
+
+    template <typename T>
+    Component::ID legacyGetID()
+    {
+        std::lock_guard<std::mutex> lock(legacyMutex);
+        std::type_index id(typeid(T));
+        auto result = std::find(legacyIDs.begin(), legacyIDs.end(), id);
+        if (result == legacyIDs.end())
+        {
+            legacyIDs.push_back(id);
+            return static_cast<Component::ID>(legacyIDs.size() - 1);
+        }
+        return static_cast<Component::ID>(std::distance(legacyIDs.begin(), result));
+    }
+
+    std::vector<std::unique_ptr<Detail::Pool>> pools(Detail::MaxComponents);
+
+    template <typename T>
+    T& legacyGetComponent(std::size_t entity)
+    {
+        auto* pool = dynamic_cast<Detail::ComponentPool<T>*>(pools[legacyGetID<T>()].get());
+        return pool->at(entity);
+    }
+
+    template <typename T>
+    T& cachedGetComponent(std::size_t entity)
+    {
+        auto* pool = static_cast<Detail::ComponentPool<T>*>(pools[Component::getID<T>()].get());
+        return pool->at(entity);
+    }
+
+    template <typename T>
+    void addToPools(std::size_t entity)
+    {
+        //both registries are populated in the same order so the IDs match
+        const auto id = Component::getID<T>();
+        check(legacyGetID<T>() == id, "legacy and cached IDs match");
+
+        if (!pools[id])
+        {
+            pools[id] = std::make_unique<Detail::ComponentPool<T>>(EntityCount);
+        }
+        static_cast<Detail::ComponentPool<T>*>(pools[id].get())->insert(entity, T());
+    }
+
+    template <int... N>
+    void addAll(std::size_t entity, std::integer_sequence<int, N...>)
+    {
+        (addToPools<TestComponent<N>>(entity), ...);
+    }
+
+    template <int... N>
+    float sumLegacy(std::size_t entity, std::integer_sequence<int, N...>)
+    {
+        return (legacyGetComponent<TestComponent<N>>(entity).value + ...);
+    }
+
+    template <int... N>
+    float sumCached(std::size_t entity, std::integer_sequence<int, N...>)
+    {
+        return (cachedGetComponent<TestComponent<N>>(entity).value + ...);
+    }
+
+    template <int... N>
+    double sumManager(EntityManager& em, const std::vector<Entity>& entities, std::integer_sequence<int, N...>)
+    {
+        double sum = 0.0;
+        for (auto e : entities)
+        {
+            sum += (em.getComponent<TestComponent<N>>(e).value + ...);
+        }
+        return sum;
+    }
+
+    template <int... N>
+    void addManager(EntityManager& em, Entity e, std::integer_sequence<int, N...>)
+    {
+        (em.addComponent<TestComponent<N>>(e), ...);
+    }
+
+    using Types = std::make_integer_sequence<int, 16>;
+    constexpr double ExpectedSum = 120.0; //0 + 1 + ... + 15
+}
+
+int main()
+{
+    for (auto i = 0u; i < EntityCount; ++i)
+    {
+        addAll(i, Types());
+    }
+
+    double legacySum = 0.0;
+    auto legacyTime = test::bestTime(Runs, [&]()
+        {
+            legacySum = 0.0;
+            for (auto j = 0; j < Iterations; ++j)
+            {
+                for (auto i = 0u; i < EntityCount; ++i)
+                {
+                    legacySum += sumLegacy(i, Types());
+                }
+            }
+        });
+
+    double cachedSum = 0.0;
+    auto cachedTime = test::bestTime(Runs, [&]()
+        {
+            cachedSum = 0.0;
+            for (auto j = 0; j < Iterations; ++j)
+            {
+                for (auto i = 0u; i < EntityCount; ++i)
+                {
+                    cachedSum += sumCached(i, Types());
+                }
+            }
+        });
+
+    check(legacySum == cachedSum, "legacy and cached lookups return the same components");
+    check(cachedSum == ExpectedSum * EntityCount * Iterations, "cached lookups return the expected components");
+
+    //the same lookups through the EntityManager
+    MessageBus mb;
+    EntityManager em(mb);
+    std::vector<Entity> entities;
+    for (auto i = 0u; i < EntityCount; ++i)
+    {
+        entities.push_back(em.createEntity());
+        addManager(em, entities.back(), Types());
+    }
+
+    double managerSum = 0.0;
+    auto managerTime = test::bestTime(Runs, [&]()
+        {
+            managerSum = 0.0;
+            for (auto j = 0; j < Iterations; ++j)
+            {
+                managerSum += sumManager(em, entities, Types());
+            }
+        });
+    check(managerSum == cachedSum, "EntityManager lookups return the expected components");
+
+    std::printf("%zu entities, 16 component types, %d iterations\n", EntityCount, Iterations);
+    test::report("type_index search + dynamic_cast", legacyTime);
+    test::report("cached ID + static_cast", cachedTime);
+    test::report("EntityManager::getComponent()", managerTime);
+
+    return test::failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//churns entities through an EntityManager, checking that indices are
+//reused from the free list, that retired indices are never handed out
+//again and that stale handles never alias a live entity.
+//Returns non-zero if any check fails
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Entity.hpp>
+#include <crogine/core/MessageBus.hpp>
+
+#include <deque>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    struct TestComponent final
+    {
+        std::size_t value = 0;
+    };
+
+    void flush(MessageBus& mb, EntityManager& em)
+    {
+        while (!mb.empty())
+        {
+            mb.poll();
+        }
+        em.flushComponentChanges();
+    }
+
+    //indices are only reused once more than MinFreeIDs are free
+    void testFreeList()
+    {
+        MessageBus mb;
+        EntityManager em(mb);
+
+        constexpr std::size_t Count = Detail::MinFreeIDs + 10;
+        std::vector<Entity> entities;
+        for (auto i = 0u; i < Count; ++i)
+        {
+            entities.push_back(em.createEntity());
+            entities.back().addComponent<TestComponent>().value = i;
+            check(entities.back().getIndex() == i, "new entities take the next index");
+            check(entities.back().getGeneration() == 0, "new indices start at generation 0");
+        }
+
+        for (auto i = 0u; i < Detail::MinFreeIDs; ++i)
+        {
+            em.destroyEntity(entities[i]);
+        }
+        flush(mb, em);
+
+        //exactly MinFreeIDs are free so this should be a new index
+        auto e = em.createEntity();
+        check(e.getIndex() == Count, "indices not reused until enough are free");
+        em.destroyEntity(e);
+
+        //now there are enough, and the oldest is reused first
+        em.destroyEntity(entities[Detail::MinFreeIDs]);
+        flush(mb, em);
+        e = em.createEntity();
+        check(e.getIndex() == 0, "oldest free index is reused first");
+        check(e.getGeneration() == 1, "reused index has the next generation");
+        check(em.entityDestroyed(entities[0]), "stale handle reports destroyed");
+        check(!em.entityDestroyed(e), "reused index is live");
+        check(!e.hasComponent<TestComponent>(), "reused index has no components");
+        check(em.getComponentPool<TestComponent>().size() == Count - (Detail::MinFreeIDs + 1), "destroyed entities release their components");
+
+        //destroying the stale handle does not affect the new entity
+        em.destroyEntity(entities[0]);
+        flush(mb, em);
+        check(!em.entityDestroyed(e), "destroying a stale handle leaves the live entity");
+    }
+
+    //churns a small window of live entities long enough that
+    //every index in use reaches MaxGeneration and is retired
+    void testRetirement()
+    {
+        MessageBus mb;
+        EntityManager em(mb);
+
+        constexpr std::size_t Window = 64;
+        constexpr std::size_t Creates = 600000;
+
+        std::vector<int> lastGeneration; //by index, -1 if never used
+        std::deque<Entity> live;
+        std::vector<Entity> stale;
+        std::size_t retired = 0;
+        bool generationsIncrease = true;
+        bool generationsInRange = true;
+        bool componentsValid = true;
+
+        for (auto i = 0u; i < Creates; ++i)
+        {
+            auto e = em.createEntity();
+            e.addComponent<TestComponent>().value = i;
+
+            const auto idx = e.getIndex();
+            if (idx >= lastGeneration.size())
+            {
+                lastGeneration.resize(idx + 1, -1);
+            }
+            generationsIncrease = generationsIncrease && (static_cast<int>(e.getGeneration()) > lastGeneration[idx]);
+            generationsInRange = generationsInRange && (e.getGeneration() < Detail::MaxGeneration);
+            lastGeneration[idx] = e.getGeneration();
+
+            live.push_back(e);
+            if (live.size() > Window)
+            {
+                auto old = live.front();
+                live.pop_front();
+
+                componentsValid = componentsValid && old.getComponent<TestComponent>().value == i - Window;
+
+                if (old.getGeneration() == Detail::MaxGeneration - 1)
+                {
+                    retired++;
+                }
+                em.destroyEntity(old);
+
+                if (i % 1000 == 0)
+                {
+                    stale.push_back(old);
+                }
+            }
+
+            if (i % 256 == 0)
+            {
+                flush(mb, em);
+            }
+        }
+        flush(mb, em);
+
+        check(generationsIncrease, "an index is never handed out twice with the same generation");
+        check(generationsInRange, "MaxGeneration is never handed out");
+        check(componentsValid, "live entities keep their components");
+        check(retired > 0, "indices are retired");
+
+        bool staleDestroyed = true;
+        for (auto e : stale)
+        {
+            staleDestroyed = staleDestroyed && em.entityDestroyed(e);
+        }
+        check(staleDestroyed, "stale handles stay destroyed");
+
+        bool liveValid = true;
+        for (auto e : live)
+        {
+            liveValid = liveValid && !em.entityDestroyed(e);
+        }
+        check(liveValid, "live entities are not destroyed");
+        check(em.getComponentPool<TestComponent>().size() == live.size(), "pool only holds live components");
+
+        //each index hands out at most MaxGeneration entities, beyond which
+        //only the free list and the live window should need new indices
+        const auto maxIndices = Creates / Detail::MaxGeneration + Detail::MinFreeIDs + Window + 2;
+        check(lastGeneration.size() <= maxIndices, "retired indices are replaced, not leaked");
+
+        std::printf("%zu entities created with %zu indices, %zu retired\n", Creates, lastGeneration.size(), retired);
+    }
+}
+
+int main()
+{
+    testFreeList();
+    testRetirement();
+
+    return test::failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//stress tests the JobSystem with parallelFor, nested waits and
+//continuations. Returns non-zero if any check fails
+
+#include "TestCommon.hpp"
+
+#include <crogine/core/JobSystem.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    constexpr int Rounds = 50;
+
+    //every index in the range is visited exactly once
+    void testParallelFor(JobSystem& jobSystem)
+    {
+        constexpr std::size_t Count = 20000;
+        std::vector<int> visits(Count);
+
+        for (auto grainSize : { std::size_t(0), std::size_t(16), std::size_t(255), Count, Count * 2 })
+        {
+            std::fill(visits.begin(), visits.end(), 0);
+            jobSystem.parallelFor(Count, grainSize,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    for (auto i = begin; i < end; ++i)
+                    {
+                        visits[i]++;
+                    }
+                });
+            check(std::all_of(visits.begin(), visits.end(), [](int v) {return v == 1; }), "parallelFor visits each index once");
+        }
+
+        //empty ranges do nothing
+        bool called = false;
+        jobSystem.parallelFor(0, 16, [&](std::size_t, std::size_t) { called = true; });
+        check(!called, "parallelFor with an empty range");
+    }
+
+    //jobs which run parallelFor, and so wait, from inside a worker
+    void testNestedWait(JobSystem& jobSystem)
+    {
+        constexpr std::size_t JobCount = 32;
+        constexpr std::size_t Count = 2000;
+        std::vector<std::atomic<std::size_t>> sums(JobCount);
+
+        JobCounter counter;
+        for (auto i = 0u; i < JobCount; ++i)
+        {
+            sums[i] = 0;
+            jobSystem.schedule([&, i]()
+                {
+                    jobSystem.parallelFor(Count, 50,
+                        [&, i](std::size_t begin, std::size_t end)
+                        {
+                            sums[i] += (end - begin);
+                        });
+                }, &counter);
+        }
+        jobSystem.wait(counter);
+
+        check(counter.complete(), "counter complete after wait");
+        check(std::all_of(sums.begin(), sums.end(), [](const std::atomic<std::size_t>& s) {return s == Count; }), "nested parallelFor completes before its job");
+    }
+
+    //jobs scheduled with a dependency only run once it is complete
+    void testContinuations(JobSystem& jobSystem)
+    {
+        constexpr int JobCount = 64;
+        std::atomic<int> firstCount = 0;
+        std::atomic<int> secondCount = 0;
+        std::atomic<int> earlyCount = 0;
+
+        JobCounter first;
+        JobCounter second;
+        for (auto i = 0; i < JobCount; ++i)
+        {
+            jobSystem.schedule([&]() { firstCount++; }, &first);
+        }
+
+        for (auto i = 0; i < JobCount; ++i)
+        {
+            jobSystem.schedule([&]()
+                {
+                    if (firstCount != JobCount)
+                    {
+                        earlyCount++;
+                    }
+                    secondCount++;
+                }, first, &second);
+        }
+        jobSystem.wait(second);
+
+        check(earlyCount == 0, "continuations wait for their dependency");
+        check(secondCount == JobCount, "all continuations run");
+
+        //a dependency which is already complete queues the job immediately
+        JobCounter third;
+        bool ran = false;
+        jobSystem.schedule([&]() { ran = true; }, first, &third);
+        jobSystem.wait(third);
+        check(ran, "continuation of a completed counter");
+
+        //a chain of jobs, each depending on the one before
+        constexpr std::size_t ChainLength = 100;
+        auto counters = std::make_unique<JobCounter[]>(ChainLength);
+        std::vector<std::size_t> order;
+        for (auto i = 0u; i < ChainLength; ++i)
+        {
+            auto job = [&order, i]() { order.push_back(i); };
+            if (i == 0)
+            {
+                jobSystem.schedule(job, &counters[i]);
+            }
+            else
+            {
+                jobSystem.schedule(job, counters[i - 1], &counters[i]);
+            }
+        }
+        jobSystem.wait(counters[ChainLength - 1]);
+
+        bool ordered = order.size() == ChainLength;
+        for (auto i = 0u; i < order.size() && ordered; ++i)
+        {
+            ordered = order[i] == i;
+        }
+        check(ordered, "chained continuations run in order");
+
+        //continuations may themselves be scheduled from within jobs
+        JobCounter outer;
+        JobCounter inner;
+        std::atomic<int> innerCount = 0;
+        jobSystem.schedule([&]()
+            {
+                JobCounter local;
+                jobSystem.schedule([&]() { innerCount++; }, &local);
+                jobSystem.schedule([&]() { innerCount++; }, local, &inner);
+                jobSystem.wait(local);
+            }, &outer);
+        jobSystem.wait(outer);
+        jobSystem.wait(inner);
+        check(innerCount == 2, "continuations scheduled from a job");
+    }
+
+    //jobs which are too big to be stored inline are still run
+    void testLargeJobs(JobSystem& jobSystem)
+    {
+        std::array<int, 32> data = {};
+        data.back() = 1;
+        std::atomic<int> result = 0;
+
+        JobCounter counter;
+        jobSystem.schedule([data, &result]() { result += data.back(); }, &counter);
+        jobSystem.wait(counter);
+        check(result == 1, "jobs larger than the inline storage");
+    }
+
+    void runAll(JobSystem& jobSystem)
+    {
+        for (auto i = 0; i < Rounds; ++i)
+        {
+            testParallelFor(jobSystem);
+            testNestedWait(jobSystem);
+            testContinuations(jobSystem);
+            testLargeJobs(jobSystem);
+        }
+    }
+}
+
+int main()
+{
+    //a single worker makes sure waiting threads execute jobs
+    //themselves rather than relying on the pool
+    for (auto threadCount : { std::size_t(1), std::size_t(4) })
+    {
+        JobSystem jobSystem(threadCount);
+        runAll(jobSystem);
+    }
+
+    return test::failures == 0 ? 0 : 1;
+}
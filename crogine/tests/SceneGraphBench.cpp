@@ -0,0 +1,213 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//times SceneGraph updates of a large hierarchy with all, some or none
+//of its transforms moving, against walking the parent chain of every
+//node as world transforms were previously calculated.
+//Returns non-zero if the SceneGraph's world transforms are incorrect
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/SceneGraph.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    constexpr std::size_t RootCount = 500;
+    constexpr std::size_t ChildCount = 3;
+    constexpr std::size_t Depth = 4; //so each root has 1 + 3 + 9 + 27 nodes
+    constexpr int Frames = 100;
+    constexpr int Runs = 3;
+
+    struct Node final
+    {
+        Entity entity;
+        std::int32_t parent = -1; //index in the node list
+    };
+
+    void addChildren(Scene& scene, std::vector<Node>& nodes, std::size_t parent, std::size_t depth, std::mt19937& rng)
+    {
+        if (depth == Depth)
+        {
+            return;
+        }
+
+        std::uniform_real_distribution<float> dist(-2.f, 2.f);
+        for (auto i = 0u; i < ChildCount; ++i)
+        {
+            auto entity = scene.createEntity();
+            auto& tx = entity.addComponent<Transform>();
+            tx.setPosition({ dist(rng), dist(rng), dist(rng) });
+            tx.setRotation({ dist(rng), dist(rng), dist(rng) });
+            tx.setParent(nodes[parent].entity);
+
+            nodes.push_back({ entity, static_cast<std::int32_t>(parent) });
+            addChildren(scene, nodes, nodes.size() - 1, depth + 1, rng);
+        }
+    }
+
+    //the world transform as it was previously calculated - the
+    //local transform multiplied by that of every parent in turn
+    glm::mat4 chainTransform(const std::vector<Node>& nodes, std::size_t idx)
+    {
+        const auto& tx = nodes[idx].entity.getComponent<Transform>();
+        if (nodes[idx].parent < 0)
+        {
+            return tx.getLocalTransform();
+        }
+        return chainTransform(nodes, nodes[idx].parent) * tx.getLocalTransform();
+    }
+
+    bool matches(const glm::mat4& a, const glm::mat4& b)
+    {
+        for (auto i = 0; i < 4; ++i)
+        {
+            for (auto j = 0; j < 4; ++j)
+            {
+                if (std::abs(a[i][j] - b[i][j]) > 0.001f)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    MessageBus mb;
+    Scene scene(mb);
+    scene.addSystem<SceneGraph>(mb);
+
+    std::mt19937 rng(1234);
+    std::vector<Node> nodes;
+    std::vector<std::size_t> roots;
+    std::vector<std::size_t> leaves;
+    for (auto i = 0u; i < RootCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<Transform>().setPosition({ static_cast<float>(i), 0.f, 0.f });
+        roots.push_back(nodes.size());
+        nodes.push_back({ entity, -1 });
+        addChildren(scene, nodes, nodes.size() - 1, 1, rng);
+    }
+
+    for (auto i = 0u; i < nodes.size(); ++i)
+    {
+        if (i % 40 == 39)
+        {
+            leaves.push_back(i); //the last node added for each root is a leaf
+        }
+    }
+    scene.simulate(Time());
+
+    //every root moves so every node is updated
+    auto allTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                for (auto r : roots)
+                {
+                    nodes[r].entity.getComponent<Transform>().rotate({ 0.f, 1.f, 0.f }, 0.01f);
+                }
+                scene.simulate(Time());
+            }
+        });
+
+    bool correct = true;
+    for (auto i = 0u; i < nodes.size() && correct; ++i)
+    {
+        correct = matches(nodes[i].entity.getComponent<Transform>().getWorldTransform(), chainTransform(nodes, i));
+    }
+    check(correct, "world transforms match the parent chain");
+
+    //one leaf per root moves, or about 2.5% of nodes
+    auto someTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                for (auto l : leaves)
+                {
+                    nodes[l].entity.getComponent<Transform>().move({ 0.f, 0.01f, 0.f });
+                }
+                scene.simulate(Time());
+            }
+        });
+
+    correct = true;
+    for (auto l : leaves)
+    {
+        correct = correct && matches(nodes[l].entity.getComponent<Transform>().getWorldTransform(), chainTransform(nodes, l));
+    }
+    check(correct, "moved leaves match the parent chain");
+
+    auto idleTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                scene.simulate(Time());
+            }
+        });
+
+    //all roots moving, with each node walking its parent chain
+    glm::mat4 sum(0.f);
+    auto chainTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Frames; ++i)
+            {
+                for (auto r : roots)
+                {
+                    nodes[r].entity.getComponent<Transform>().rotate({ 0.f, 1.f, 0.f }, 0.01f);
+                }
+
+                for (auto j = 0u; j < nodes.size(); ++j)
+                {
+                    sum += chainTransform(nodes, j);
+                }
+            }
+        });
+
+    std::printf("%zu transforms, %zu levels deep, %d frames\n", nodes.size(), Depth, Frames);
+    test::report("SceneGraph, all moving", allTime);
+    test::report("SceneGraph, one leaf per root moving", someTime);
+    test::report("SceneGraph, none moving", idleTime);
+    test::report("parent chain per node, all moving", chainTime);
+
+    return (test::failures == 0 && sum[0][0] == sum[0][0]) ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//checks the transforms seen while a Scene is rendered with SceneGraph
+//interpolation enabled are blended between the last two simulation
+//steps, and that the simulation's transforms are restored afterwards.
+//Returns non-zero if any are incorrect
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/SceneGraph.hpp>
+
+#include <cmath>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    bool matches(glm::vec3 a, glm::vec3 b)
+    {
+        return std::abs(a.x - b.x) < 0.001f
+            && std::abs(a.y - b.y) < 0.001f
+            && std::abs(a.z - b.z) < 0.001f;
+    }
+
+    //records what renderers see of a transform
+    class RenderRecorder final : public System, public Renderable
+    {
+    public:
+        explicit RenderRecorder(MessageBus& mb)
+            : System(mb, typeid(RenderRecorder)), target(0, 0)
+        {
+            requireComponent<Transform>();
+        }
+
+        void render(Entity) override
+        {
+            const auto& tx = target.getComponent<Transform>();
+            worldPosition = tx.getWorldPosition();
+            worldScale = tx.getWorldScale();
+            matrixPosition = glm::vec3(tx.getWorldTransform()[3]);
+            matrixScale = glm::length(glm::vec3(tx.getWorldTransform()[0]));
+        }
+
+        Entity target;
+        glm::vec3 worldPosition = glm::vec3(0.f);
+        glm::vec3 worldScale = glm::vec3(0.f);
+        glm::vec3 matrixPosition = glm::vec3(0.f);
+        float matrixScale = 0.f;
+    };
+}
+
+int main()
+{
+    MessageBus mb;
+    Scene scene(mb);
+    scene.addSystem<SceneGraph>(mb).setInterpolationEnabled(true);
+    auto& recorder = scene.addSystem<RenderRecorder>(mb);
+
+    auto parent = scene.createEntity();
+    parent.addComponent<Transform>();
+    auto child = scene.createEntity();
+    child.addComponent<Transform>().setPosition({ 1.f, 0.f, 0.f });
+    child.getComponent<Transform>().setParent(parent);
+    scene.simulate(Time());
+
+    //halfway through a quarter turn of the parent the child is at 45 degrees,
+    //rather than on the chord between its previous and current positions
+    parent.getComponent<Transform>().rotate({ 0.f, 0.f, 1.f }, 1.5707963f);
+    scene.simulate(Time());
+
+    recorder.target = child;
+    test::interpolationAlpha = 0.5f;
+    scene.render();
+
+    const glm::vec3 halfway(0.7071068f, 0.7071068f, 0.f);
+    check(matches(recorder.worldPosition, halfway), "blended child world position");
+    check(matches(recorder.matrixPosition, halfway), "blended child world transform");
+    check(matches(recorder.worldScale, glm::vec3(1.f)) && std::abs(recorder.matrixScale - 1.f) < 0.001f, "blended rotation keeps its scale");
+    check(matches(child.getComponent<Transform>().getWorldPosition(), { 0.f, 1.f, 0.f }), "child restored after rendering");
+
+    //roots are blended too
+    parent.getComponent<Transform>().setRotation({ 0.f, 0.f, 0.f });
+    scene.simulate(Time());
+    scene.simulate(Time());
+    parent.getComponent<Transform>().move({ 8.f, 0.f, 0.f });
+    parent.getComponent<Transform>().setScale({ 3.f, 3.f, 3.f });
+    scene.simulate(Time());
+
+    recorder.target = parent;
+    test::interpolationAlpha = 0.25f;
+    scene.render();
+    check(matches(recorder.worldPosition, { 2.f, 0.f, 0.f }), "blended root world position");
+    check(matches(recorder.matrixPosition, { 2.f, 0.f, 0.f }), "blended root world transform");
+    check(matches(recorder.worldScale, glm::vec3(1.5f)), "blended root world scale");
+    check(matches(parent.getComponent<Transform>().getWorldPosition(), { 8.f, 0.f, 0.f })
+        && matches(parent.getComponent<Transform>().getScale(), glm::vec3(3.f)), "root restored after rendering");
+
+    //once a transform has stopped moving there's nothing to blend
+    scene.simulate(Time());
+    scene.render();
+    check(matches(recorder.worldPosition, { 8.f, 0.f, 0.f }), "transform at rest isn't blended");
+
+    //transforms aren't blended between different parents
+    auto other = scene.createEntity();
+    other.addComponent<Transform>().setPosition({ 0.f, 50.f, 0.f });
+    scene.simulate(Time());
+    child.getComponent<Transform>().setParent(other);
+    scene.simulate(Time());
+
+    recorder.target = child;
+    scene.render();
+    check(matches(recorder.worldPosition, { 1.f, 50.f, 0.f }), "reparented transform isn't blended");
+
+    return test::failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//stands in for the parts of the App, Window and graphics classes
+//which a Scene touches, so that tests can create and simulate
+//Scenes without a window or GL context, or linking the library.
+//Nothing here may be rendered, unless the test stubs the GL functions too.
+
+#include "TestCommon.hpp"
+
+#include <crogine/core/App.hpp>
+#include <crogine/core/Console.hpp>
+#include <crogine/core/Window.hpp>
+#include <crogine/graphics/LoadingScreen.hpp>
+#include <crogine/graphics/RenderTexture.hpp>
+#include <crogine/graphics/postprocess/PostProcess.hpp>
+
+#include <SDL_timer.h>
+
+#include <chrono>
+
+using namespace cro;
+
+JobSystem& App::getJobSystem()
+{
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+Window& App::getWindow()
+{
+    static Window window;
+    return window;
+}
+
+float App::getInterpolationAlpha()
+{
+    return test::interpolationAlpha;
+}
+
+void Console::print(const std::string&) {}
+
+Window::Window() {}
+
+Window::~Window() {}
+
+glm::uvec2 Window::getSize() const
+{
+    return { 1280u, 720u };
+}
+
+Detail::SDLResource::SDLResource() {}
+
+Texture::Texture() {}
+
+Texture::~Texture() {}
+
+uint32 Texture::getGLHandle() const
+{
+    return 0;
+}
+
+RenderTexture::RenderTexture() {}
+
+RenderTexture::~RenderTexture() {}
+
+bool RenderTexture::create(uint32, uint32, bool, bool)
+{
+    return false;
+}
+
+void RenderTexture::clear(Colour) {}
+
+void RenderTexture::display() {}
+
+URect RenderTexture::getDefaultViewport() const
+{
+    return {};
+}
+
+void PostProcess::resizeBuffer(int32, int32) {}
+
+Uint32 SDL_GetTicks(void)
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return static_cast<Uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
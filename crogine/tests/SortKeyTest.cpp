@@ -0,0 +1,197 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//tests the draw order produced by sorting ModelRenderer's sort keys.
+//returns non-zero if any check fails
+
+#include "ecs/SortKey.hpp"
+#include "detail/RadixSort.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool result, const char* name)
+    {
+        if (!result)
+        {
+            std::printf("FAILED: %s\n", name);
+            failures++;
+        }
+    }
+
+    struct Item final
+    {
+        bool transparent = false;
+        uint32 shader = 0;
+        uint32 material = 0;
+        uint32 mesh = 0;
+        float depth = 0.f;
+    };
+
+    //returns the items in sorted order
+    std::vector<Item> sortItems(const std::vector<Item>& items)
+    {
+        std::vector<Detail::SortItem> keys;
+        for (auto i = 0u; i < items.size(); ++i)
+        {
+            const auto& item = items[i];
+            keys.emplace_back(Detail::makeSortKey(item.transparent, item.shader, item.material, item.mesh, item.depth), i);
+        }
+
+        std::vector<Detail::SortItem> buffer;
+        Detail::radixSort(keys, buffer);
+
+        std::vector<Item> retVal;
+        for (const auto& [key, idx] : keys)
+        {
+            retVal.push_back(items[idx]);
+        }
+        return retVal;
+    }
+
+    std::vector<Item> randomItems(std::size_t count, float transparentChance, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<uint32> state(1, 4);
+        std::uniform_real_distribution<float> depth(0.1f, 280.f);
+        std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+        std::vector<Item> items(count);
+        for (auto& item : items)
+        {
+            item.transparent = chance(rng) < transparentChance;
+            item.shader = state(rng);
+            item.material = state(rng);
+            item.mesh = state(rng);
+            item.depth = depth(rng);
+        }
+        return items;
+    }
+
+    void testOpaqueGrouping(std::mt19937& rng)
+    {
+        const auto sorted = sortItems(randomItems(1000, 0.f, rng));
+
+        //each shader/material/mesh combination forms a single run,
+        //ordered by shader then material then mesh
+        bool grouped = true;
+        for (auto i = 1u; i < sorted.size(); ++i)
+        {
+            const auto& a = sorted[i - 1];
+            const auto& b = sorted[i];
+            grouped = grouped && (std::tie(a.shader, a.material, a.mesh) <= std::tie(b.shader, b.material, b.mesh));
+        }
+        check(grouped, "opaque items are grouped by shader, material and mesh");
+    }
+
+    void testFrontToBack(std::mt19937& rng)
+    {
+        auto items = randomItems(1000, 0.f, rng);
+        for (auto& item : items)
+        {
+            item.shader = item.material = item.mesh = 1;
+        }
+
+        //items behind the camera are treated as being at the near plane
+        items[0].depth = -5.f;
+        items[1].depth = 1.f;
+        items[2].depth = 1.001f;
+
+        const auto sorted = sortItems(items);
+        check(std::is_sorted(sorted.begin(), sorted.end(),
+            [](const Item& a, const Item& b) { return std::max(0.f, a.depth) < std::max(0.f, b.depth); }),
+            "opaque items with the same state are drawn front to back");
+        check(sorted[0].depth == -5.f, "negative depth is drawn first");
+    }
+
+    void testTransparentLast(std::mt19937& rng)
+    {
+        const auto sorted = sortItems(randomItems(1000, 0.3f, rng));
+
+        const auto firstTransparent = std::find_if(sorted.begin(), sorted.end(), [](const Item& i) { return i.transparent; });
+        check(firstTransparent != sorted.end(), "transparent items exist");
+        check(std::all_of(firstTransparent, sorted.end(), [](const Item& i) { return i.transparent; }),
+            "transparent items are drawn after all opaque items");
+        check(std::is_sorted(firstTransparent, sorted.end(), [](const Item& a, const Item& b) { return a.depth > b.depth; }),
+            "transparent items are drawn back to front");
+    }
+
+    void testStability(std::mt19937& rng)
+    {
+        //few distinct keys so there are plenty of duplicates, spread
+        //over all bytes of the key so every radix pass is used
+        std::uniform_int_distribution<uint64> dist(0, 15);
+        std::vector<Detail::SortItem> items;
+        for (auto i = 0u; i < 5000; ++i)
+        {
+            const auto v = dist(rng);
+            items.emplace_back((v << 60) | (v << 28) | v, i);
+        }
+
+        auto expected = items;
+        std::stable_sort(expected.begin(), expected.end(),
+            [](const Detail::SortItem& a, const Detail::SortItem& b) { return a.first < b.first; });
+
+        std::vector<Detail::SortItem> buffer;
+        Detail::radixSort(items, buffer);
+        check(items == expected, "items with equal keys keep their order");
+
+        //sorting again reuses the buffer and must not change the result
+        Detail::radixSort(items, buffer);
+        check(items == expected, "sorting sorted items is a no-op");
+
+        std::vector<Detail::SortItem> empty;
+        Detail::radixSort(empty, buffer);
+        check(empty.empty(), "sorting no items");
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+
+    testOpaqueGrouping(rng);
+    testFrontToBack(rng);
+    testTransparentLast(rng);
+    testStability(rng);
+
+    if (failures == 0)
+    {
+        std::printf("All sort key tests passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+#pragma once
+
+//shared helpers for the crogine tests and benchmarks
+
+#include <chrono>
+#include <cstdio>
+
+namespace test
+{
+    inline int failures = 0;
+
+    //returned by App::getInterpolationAlpha() in tests which link SceneStubs.cpp
+    inline float interpolationAlpha = 1.f;
+
+    inline void check(bool result, const char* name)
+    {
+        if (!result)
+        {
+            std::printf("FAILED: %s\n", name);
+            failures++;
+        }
+    }
+
+    //returns the best time in milliseconds of the given number of runs of func
+    template <typename F>
+    double bestTime(int runs, F&& func)
+    {
+        double best = 0.0;
+        for (auto i = 0; i < runs; ++i)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            func();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+            if (i == 0 || elapsed.count() < best)
+            {
+                best = elapsed.count();
+            }
+        }
+        return best;
+    }
+
+    inline void report(const char* name, double ms)
+    {
+        std::printf("%-40s %10.3f ms\n", name, ms);
+    }
+}
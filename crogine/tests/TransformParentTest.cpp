@@ -0,0 +1,123 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//checks the world position, rotation and scale of transforms which are
+//parented, reparented and unparented both before and after the SceneGraph
+//has linked them, and the child ID lists built from the hierarchy.
+//Returns non-zero if any are incorrect
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Renderable.hpp>
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/SceneGraph.hpp>
+
+#include <cmath>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    bool matches(glm::vec3 a, glm::vec3 b)
+    {
+        return std::abs(a.x - b.x) < 0.001f
+            && std::abs(a.y - b.y) < 0.001f
+            && std::abs(a.z - b.z) < 0.001f;
+    }
+
+    Entity createNode(Scene& scene, glm::vec3 position)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<Transform>().setPosition(position);
+        return entity;
+    }
+}
+
+int main()
+{
+    MessageBus mb;
+    Scene scene(mb);
+    scene.addSystem<SceneGraph>(mb);
+
+    //parent and child created this frame, before the SceneGraph has seen either
+    auto root = createNode(scene, { 10.f, 0.f, 0.f });
+    root.getComponent<Transform>().setScale({ 2.f, 2.f, 2.f });
+    auto child = createNode(scene, { 1.f, 2.f, 0.f });
+    child.getComponent<Transform>().setParent(root);
+
+    const glm::vec3 expected(12.f, 4.f, 0.f);
+    check(matches(child.getComponent<Transform>().getWorldPosition(), expected), "new child world position before update");
+    check(matches(child.getComponent<Transform>().getWorldScale(), glm::vec3(2.f)), "new child world scale before update");
+
+    //a chain of pending links resolves through each parent
+    auto grandchild = createNode(scene, { 0.f, 0.f, 1.f });
+    grandchild.getComponent<Transform>().setParent(child);
+    check(matches(grandchild.getComponent<Transform>().getWorldPosition(), expected + glm::vec3(0.f, 0.f, 2.f)), "pending chain world position");
+
+    scene.simulate(Time());
+    check(matches(child.getComponent<Transform>().getWorldPosition(), expected), "child world position after update");
+    check(matches(glm::vec3(child.getComponent<Transform>().getWorldTransform()[3]), expected), "child world transform after update");
+
+    //reparent a linked child, the new parent is used before the next update
+    auto other = createNode(scene, { 0.f, 5.f, 0.f });
+    other.getComponent<Transform>().rotate({ 0.f, 0.f, 1.f }, 3.14159265f);
+    child.getComponent<Transform>().setParent(other);
+
+    const glm::vec3 reparented(-1.f, 3.f, 0.f);
+    check(matches(child.getComponent<Transform>().getWorldPosition(), reparented), "reparented world position before update");
+    check(matches(glm::vec3(child.getComponent<Transform>().getWorldTransform()[3]), reparented), "reparented world transform before update");
+    check(std::abs(glm::dot(child.getComponent<Transform>().getWorldRotation(), other.getComponent<Transform>().getRotationQuat())) > 0.999f, "reparented world rotation before update");
+
+    scene.simulate(Time());
+    check(matches(child.getComponent<Transform>().getWorldPosition(), reparented), "reparented world position after update");
+    check(matches(grandchild.getComponent<Transform>().getWorldPosition(), reparented + glm::vec3(0.f, 0.f, 1.f)), "grandchild follows reparented child");
+
+    //removing the parent returns the local position straight away
+    child.getComponent<Transform>().removeParent();
+    check(matches(child.getComponent<Transform>().getWorldPosition(), { 1.f, 2.f, 0.f }), "unparented world position before update");
+    scene.simulate(Time());
+    check(matches(child.getComponent<Transform>().getWorldPosition(), { 1.f, 2.f, 0.f }), "unparented world position after update");
+
+    //child lists are sorted by descending ID and terminated with -1
+    auto second = createNode(scene, {});
+    second.getComponent<Transform>().setParent(root);
+    child.getComponent<Transform>().setParent(root);
+    scene.simulate(Time());
+
+    const auto& ids = root.getComponent<Transform>().getChildIDs();
+    check(ids.size() == 3, "root has two children");
+    check(ids.size() == 3 && ids[0] == static_cast<int32>(second.getIndex()) && ids[1] == static_cast<int32>(child.getIndex()) && ids[2] == -1, "child IDs are sorted and terminated");
+    check(other.getComponent<Transform>().getChildIDs().size() == 1
+        && other.getComponent<Transform>().getChildIDs()[0] == -1, "childless transform returns an empty list");
+
+    return test::failures == 0 ? 0 : 1;
+}
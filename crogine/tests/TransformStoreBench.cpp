@@ -0,0 +1,160 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//compares composing dirty local transforms one at a time with glm,
+//as Transform::getLocalTransform() does, against batching them with
+//the TransformStore as the SceneGraph does.
+//Returns non-zero if the two disagree
+
+#include "TestCommon.hpp"
+#include "ecs/TransformStore.hpp"
+
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/detail/glm/gtc/matrix_transform.hpp>
+#include <crogine/detail/glm/gtx/quaternion.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    constexpr std::size_t Count = 20000;
+    constexpr int Iterations = 50;
+    constexpr int Runs = 5;
+
+    //has the same size as a Transform component so that
+    //walking the array touches memory as the SceneGraph would
+    struct Node final
+    {
+        glm::vec3 origin = glm::vec3(0.f);
+        glm::vec3 position = glm::vec3(0.f);
+        glm::vec3 scale = glm::vec3(1.f);
+        glm::quat rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+        glm::mat4 transform = glm::mat4(1.f);
+        char padding[sizeof(Transform) - (sizeof(glm::vec3) * 3 + sizeof(glm::quat) + sizeof(glm::mat4))] = {};
+    };
+    static_assert(sizeof(Node) == sizeof(Transform));
+
+    //as Transform::getLocalTransform()
+    void composeInPlace(Node& node)
+    {
+        glm::mat4 translation = glm::translate(glm::mat4(1.f), node.position);
+
+        auto rotation = glm::toMat4(node.rotation);
+        rotation = glm::scale(rotation, node.scale);
+        rotation = glm::translate(rotation, -node.origin);
+
+        node.transform = translation * rotation;
+    }
+
+    bool matches(const glm::mat4& a, const glm::mat4& b)
+    {
+        for (auto i = 0; i < 4; ++i)
+        {
+            for (auto j = 0; j < 4; ++j)
+            {
+                if (std::abs(a[i][j] - b[i][j]) > 0.0001f)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-10.f, 10.f);
+
+    std::vector<Node> nodes(Count);
+    for (auto& node : nodes)
+    {
+        node.origin = { dist(rng), dist(rng), dist(rng) };
+        node.position = { dist(rng), dist(rng), dist(rng) };
+        node.scale = glm::abs(glm::vec3(dist(rng), dist(rng), dist(rng))) + 0.1f;
+        node.rotation = glm::normalize(glm::quat(dist(rng), dist(rng), dist(rng), dist(rng)));
+    }
+    auto expected = nodes;
+    for (auto& node : expected)
+    {
+        composeInPlace(node);
+    }
+
+    auto inPlaceTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Iterations; ++i)
+            {
+                for (auto& node : nodes)
+                {
+                    composeInPlace(node);
+                }
+            }
+        });
+
+    bool correct = true;
+    for (auto i = 0u; i < Count; ++i)
+    {
+        correct = correct && matches(nodes[i].transform, expected[i].transform);
+        nodes[i].transform = glm::mat4(1.f);
+    }
+    check(correct, "composing in place");
+
+    Detail::TransformStore store;
+    auto batchedTime = test::bestTime(Runs, [&]()
+        {
+            for (auto i = 0; i < Iterations; ++i)
+            {
+                store.clear();
+                for (auto& node : nodes)
+                {
+                    store.push(node.position, node.rotation, node.scale, node.origin, node.transform);
+                }
+                store.composeLocal();
+            }
+        });
+
+    correct = true;
+    for (auto i = 0u; i < Count; ++i)
+    {
+        correct = correct && matches(nodes[i].transform, expected[i].transform);
+    }
+    check(correct, "composing with the TransformStore");
+
+    std::printf("%zu transforms, %d iterations\n", Count, Iterations);
+    test::report("one at a time with glm", inPlaceTime);
+    test::report("batched with the TransformStore", batchedTime);
+
+    return test::failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2020
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+//checks that ModelRenderer sets the camera and sunlight uniforms once
+//per shader in each render pass, rather than once for every material
+//or draw. The GL functions it calls are replaced with stubs, which
+//count the uniform uploads made to each shader program.
+//Returns non-zero if any uniform is uploaded an unexpected number of times
+
+#include "TestCommon.hpp"
+
+#include <crogine/ecs/Scene.hpp>
+#include <crogine/ecs/components/Model.hpp>
+#include <crogine/ecs/components/Transform.hpp>
+#include <crogine/ecs/systems/CameraSystem.hpp>
+#include <crogine/ecs/systems/ModelRenderer.hpp>
+
+#include "../src/detail/glad.hpp"
+
+#include <map>
+#include <utility>
+
+using namespace cro;
+
+namespace
+{
+    using test::check;
+
+    const int32 ColourLocation = Material::Uniform::Total;
+
+    GLuint currentProgram = 0;
+    std::map<std::pair<GLuint, GLint>, int> uploads;
+
+    int uploadCount(GLuint program, GLint location)
+    {
+        auto result = uploads.find(std::make_pair(program, location));
+        return result == uploads.end() ? 0 : result->second;
+    }
+
+    void APIENTRY countUpload(GLint location)
+    {
+        uploads[std::make_pair(currentProgram, location)]++;
+    }
+
+    void APIENTRY uniform1i(GLint location, GLint) { countUpload(location); }
+    void APIENTRY uniform1f(GLint location, GLfloat) { countUpload(location); }
+    void APIENTRY uniform2f(GLint location, GLfloat, GLfloat) { countUpload(location); }
+    void APIENTRY uniform3f(GLint location, GLfloat, GLfloat, GLfloat) { countUpload(location); }
+    void APIENTRY uniform4f(GLint location, GLfloat, GLfloat, GLfloat, GLfloat) { countUpload(location); }
+    void APIENTRY uniformMatrix3fv(GLint location, GLsizei, GLboolean, const GLfloat*) { countUpload(location); }
+    void APIENTRY uniformMatrix4fv(GLint location, GLsizei, GLboolean, const GLfloat*) { countUpload(location); }
+    void APIENTRY useProgram(GLuint program) { currentProgram = program; }
+
+    //a version without instancing, so that every model is a separate draw
+    const GLubyte* APIENTRY getString(GLenum) { return reinterpret_cast<const GLubyte*>("2.1"); }
+    GLenum APIENTRY getError() { return GL_NO_ERROR; }
+
+    //everything else ModelRenderer calls does nothing
+    void APIENTRY getIntegerv(GLenum, GLint*) {}
+    void APIENTRY viewport(GLint, GLint, GLsizei, GLsizei) {}
+    void APIENTRY bindBuffer(GLenum, GLuint) {}
+    void APIENTRY activeTexture(GLenum) {}
+    void APIENTRY bindTexture(GLenum, GLuint) {}
+    void APIENTRY capability(GLenum) {}
+    void APIENTRY depthMask(GLboolean) {}
+    void APIENTRY cullFace(GLenum) {}
+    void APIENTRY blendFunc(GLenum, GLenum) {}
+    void APIENTRY blendEquation(GLenum) {}
+    void APIENTRY vertexAttribArray(GLuint) {}
+    void APIENTRY vertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+    void APIENTRY vertexAttribv(GLuint, const GLfloat*) {}
+    void APIENTRY drawElements(GLenum, GLsizei, GLenum, const void*) {}
+
+    void stubGL()
+    {
+        glad_glUniform1i = uniform1i;
+        glad_glUniform1f = uniform1f;
+        glad_glUniform2f = uniform2f;
+        glad_glUniform3f = uniform3f;
+        glad_glUniform4f = uniform4f;
+        glad_glUniformMatrix3fv = uniformMatrix3fv;
+        glad_glUniformMatrix4fv = uniformMatrix4fv;
+        glad_glUseProgram = useProgram;
+        glad_glGetString = getString;
+        glad_glGetError = getError;
+        glad_glGetIntegerv = getIntegerv;
+        glad_glViewport = viewport;
+        glad_glBindBuffer = bindBuffer;
+        glad_glActiveTexture = activeTexture;
+        glad_glBindTexture = bindTexture;
+        glad_glEnable = capability;
+        glad_glDisable = capability;
+        glad_glDepthMask = depthMask;
+        glad_glCullFace = cullFace;
+        glad_glBlendFunc = blendFunc;
+        glad_glBlendEquation = blendEquation;
+        glad_glEnableVertexAttribArray = vertexAttribArray;
+        glad_glDisableVertexAttribArray = vertexAttribArray;
+        glad_glVertexAttribPointer = vertexAttribPointer;
+        glad_glVertexAttrib3fv = vertexAttribv;
+        glad_glVertexAttrib4fv = vertexAttribv;
+        glad_glDrawElements = drawElements;
+    }
+
+    //a material as MaterialResource would create it, with a uniform
+    //location for each standard uniform and a colour property
+    Material::Data createMaterial(uint32 shader, int32 id)
+    {
+        Material::Data material;
+        material.shader = shader;
+        material.id = id;
+        for (auto i = 0; i < Material::Uniform::Total; ++i)
+        {
+            material.uniforms[i] = i;
+        }
+        material.optionalUniforms[material.optionalUniformCount++] = Material::SunlightColour;
+        material.optionalUniforms[material.optionalUniformCount++] = Material::SunlightDirection;
+        material.properties.insert(std::make_pair("u_colour", std::make_pair(ColourLocation, Material::Property())));
+        material.setProperty("u_colour", Colour::White());
+        return material;
+    }
+
+    Mesh::Data createMesh()
+    {
+        Mesh::Data mesh;
+        mesh.vbo = 1;
+        mesh.attributes[Mesh::Position] = 3;
+        mesh.vertexSize = 3 * sizeof(float);
+        mesh.submeshCount = 1;
+        mesh.indexData[0].ibo = 1;
+        mesh.indexData[0].indexCount = 3;
+        mesh.boundingSphere.radius = 1.f;
+        return mesh;
+    }
+}
+
+int main()
+{
+    stubGL();
+
+    MessageBus mb;
+    Scene scene(mb);
+    scene.addSystem<CameraSystem>(mb);
+    scene.addSystem<ModelRenderer>(mb);
+
+    //two materials share the first shader, so its draws are
+    //sorted together and its uniforms could be set per material
+    const uint32 FirstShader = 1;
+    const uint32 SecondShader = 2;
+    const std::array<std::pair<uint32, int32>, 5u> models =
+    {
+        std::make_pair(FirstShader, 1),
+        std::make_pair(FirstShader, 1),
+        std::make_pair(FirstShader, 2),
+        std::make_pair(SecondShader, 3),
+        std::make_pair(SecondShader, 3)
+    };
+
+    auto mesh = createMesh();
+    for (auto i = 0u; i < models.size(); ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<Transform>().setPosition({ -4.f + (2.f * i), 0.f, -20.f });
+        entity.addComponent<Model>(mesh, createMaterial(models[i].first, models[i].second));
+    }
+
+    for (auto pass = 0; pass < 2; ++pass)
+    {
+        uploads.clear();
+        scene.simulate(Time());
+        scene.render();
+
+        for (auto [shader, drawCount] : { std::make_pair(FirstShader, 3), std::make_pair(SecondShader, 2) })
+        {
+            //per pass values
+            check(uploadCount(shader, Material::Projection) == 1, "projection uploaded once per shader");
+            check(uploadCount(shader, Material::View) == 1, "view uploaded once per shader");
+            check(uploadCount(shader, Material::Camera) == 1, "camera position uploaded once per shader");
+            check(uploadCount(shader, Material::SunlightColour) == 1, "sunlight colour uploaded once per shader");
+            check(uploadCount(shader, Material::SunlightDirection) == 1, "sunlight direction uploaded once per shader");
+
+            //per draw values
+            check(uploadCount(shader, Material::World) == drawCount, "world matrix uploaded for each draw");
+            check(uploadCount(shader, ColourLocation) == drawCount, "material properties uploaded for each draw");
+        }
+    }
+
+    return test::failures == 0 ? 0 : 1;
+}
@@ -51,6 +51,8 @@ PlayerWeaponSystem::PlayerWeaponSystem(cro::MessageBus& mb)
 {
     requireComponent<PlayerWeapon>();
     requireComponent<cro::Transform>();
+
+    subscribe(MessageID::WeaponMessage);
 }
 
 //public
@@ -56,6 +56,8 @@ BackgroundSystem::BackgroundSystem(cro::MessageBus& mb)
     requireComponent<BackgroundComponent>();
     requireComponent<cro::Model>();
 
+    subscribe(MessageID::GameMessage);
+
     for (auto& t : noiseTable)
     {
         t = cro::Util::Random::value(-0.0008f, 0.0008f);
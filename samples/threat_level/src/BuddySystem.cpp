@@ -52,6 +52,8 @@ BuddySystem::BuddySystem(cro::MessageBus& mb)
 {
     requireComponent<Buddy>();
     requireComponent<cro::Transform>();
+
+    subscribe(MessageID::PlayerMessage);
 }
 
 //public
@@ -1091,23 +1091,22 @@ void GameState::loadWeapons()
 
     auto orbScale = glm::vec3(0.005f);
     static const std::size_t orbCount = 20;
-    for (auto i = 0u; i < orbCount; ++i)
-    {
-        entity = m_scene.createEntity();
-        entity.addComponent<cro::Sprite>() = spriteSheet.getSprite("npc_orb");
-        size = entity.getComponent<cro::Sprite>().getSize();
 
-        entity.addComponent<cro::Transform>().setPosition({ 0.f, 10.f, -8.f });
-        entity.getComponent<cro::Transform>().setOrigin({ size.x / 2.f, size.y / 2.f, 0.f });
-        entity.getComponent<cro::Transform>().setScale(orbScale);
+    cro::Prefab orbPrefab;
+    orbPrefab.addComponent<cro::Sprite>() = spriteSheet.getSprite("npc_orb");
+    size = orbPrefab.getComponent<cro::Sprite>().getSize();
 
-        ps.extent = glm::vec3(size.x / 2.f, size.y / 2.f, 1.f) * orbScale;
-        entity.addComponent<cro::PhysicsObject>().addShape(ps);
-        entity.getComponent<cro::PhysicsObject>().setCollisionGroups(CollisionID::NpcLaser);
-        entity.getComponent<cro::PhysicsObject>().setCollisionFlags(CollisionID::Bounds | CollisionID::Environment | CollisionID::Player);
+    orbPrefab.addComponent<cro::Transform>().setPosition({ 0.f, 10.f, -8.f });
+    orbPrefab.getComponent<cro::Transform>().setOrigin({ size.x / 2.f, size.y / 2.f, 0.f });
+    orbPrefab.getComponent<cro::Transform>().setScale(orbScale);
 
-        entity.addComponent<NpcWeapon>().type = NpcWeapon::Orb;
-    }
+    ps.extent = glm::vec3(size.x / 2.f, size.y / 2.f, 1.f) * orbScale;
+    orbPrefab.addComponent<cro::PhysicsObject>().addShape(ps);
+    orbPrefab.getComponent<cro::PhysicsObject>().setCollisionGroups(CollisionID::NpcLaser);
+    orbPrefab.getComponent<cro::PhysicsObject>().setCollisionFlags(CollisionID::Bounds | CollisionID::Environment | CollisionID::Player);
+
+    orbPrefab.addComponent<NpcWeapon>().type = NpcWeapon::Orb;
+    m_scene.instantiate(orbPrefab, orbCount);
 
     //elite laser is an orb and a beam attached to the weapon ent (see elite entity above)
     laserScale.y = 0.004f;
@@ -1146,28 +1145,25 @@ void GameState::loadWeapons()
     //choppa pulses
     static const std::size_t choppaPulseCount = 18;
     pulseScale *= 0.5f;
-    for (auto i = 0u; i < choppaPulseCount; ++i)
-    {
-        entity = m_scene.createEntity();
-        entity.addComponent<cro::Sprite>() = spriteSheet.getSprite("npc_pulse");
-        auto size = entity.getComponent<cro::Sprite>().getSize();
+    cro::Prefab pulsePrefab;
+    pulsePrefab.addComponent<cro::Sprite>() = spriteSheet.getSprite("npc_pulse");
+    size = pulsePrefab.getComponent<cro::Sprite>().getSize();
 
-        entity.addComponent<cro::Transform>().setScale(pulseScale);
-        entity.getComponent<cro::Transform>().setPosition(glm::vec3(10.f));
-        entity.getComponent<cro::Transform>().setOrigin({ size.x / 2.f, size.y / 2.f, 0.f });
+    pulsePrefab.addComponent<cro::Transform>().setScale(pulseScale);
+    pulsePrefab.getComponent<cro::Transform>().setPosition(glm::vec3(10.f));
+    pulsePrefab.getComponent<cro::Transform>().setOrigin({ size.x / 2.f, size.y / 2.f, 0.f });
 
-        //cro::PhysicsShape cs;
-        ps.type = cro::PhysicsShape::Type::Box;
-        ps.extent = { size.x * pulseScale.x, size.y * pulseScale.y, 0.2f };
-        ps.extent /= 2.f;
-        ps.extent *= glm::vec3(0.85f);
+    ps.type = cro::PhysicsShape::Type::Box;
+    ps.extent = { size.x * pulseScale.x, size.y * pulseScale.y, 0.2f };
+    ps.extent /= 2.f;
+    ps.extent *= glm::vec3(0.85f);
 
-        entity.addComponent<cro::PhysicsObject>().setCollisionGroups(CollisionID::NpcLaser);
-        entity.getComponent<cro::PhysicsObject>().setCollisionFlags(CollisionID::Bounds | CollisionID::Player);
-        entity.getComponent<cro::PhysicsObject>().addShape(ps);
+    pulsePrefab.addComponent<cro::PhysicsObject>().setCollisionGroups(CollisionID::NpcLaser);
+    pulsePrefab.getComponent<cro::PhysicsObject>().setCollisionFlags(CollisionID::Bounds | CollisionID::Player);
+    pulsePrefab.getComponent<cro::PhysicsObject>().addShape(ps);
 
-        entity.addComponent<NpcWeapon>().type = NpcWeapon::Pulse;
-    }
+    pulsePrefab.addComponent<NpcWeapon>().type = NpcWeapon::Pulse;
+    m_scene.instantiate(pulsePrefab, choppaPulseCount);
 }
 
 void GameState::updateView()
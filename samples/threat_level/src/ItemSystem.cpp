@@ -54,6 +54,8 @@ ItemSystem::ItemSystem(cro::MessageBus& mb)
     requireComponent<cro::Transform>();
     requireComponent<cro::Model>();
     requireComponent<cro::PhysicsObject>();
+
+    subscribe(MessageID::PlayerMessage);
 }
 
 //public
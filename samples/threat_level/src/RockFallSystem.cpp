@@ -52,6 +52,8 @@ RockFallSystem::RockFallSystem(cro::MessageBus& mb)
 {
     requireComponent<cro::Transform>();
     requireComponent<RockFall>();
+
+    subscribe(MessageID::BackgroundSystem);
 }
 
 //public